@@ -0,0 +1,280 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+#include <cstdint>
+using namespace std;
+
+/**
+ * A set of cells on the 10x10 grid packed into 128 bits (bit index = row * SIZE + col).
+ * The low word holds cells 0-63 and the high word holds cells 64-99; unused high bits are always zero.
+ * Everything is defined inline here since board access is the hottest part of a game.
+ */
+class Bitboard {
+public:
+    static const int SIZE = 10;
+    static const int NUM_CELLS = SIZE * SIZE;
+    static const int MAX_RUN = 7; // Longest vertical run Run() can build in one word
+
+    Bitboard();
+    Bitboard(uint64_t lowBits, uint64_t highBits);
+
+    /**
+     * Converts a row and column into a bit index.
+     * @param row Row of coordinate.
+     * @param col Column of coordinate.
+     * @return Bit index of the cell.
+     */
+    static int Index(int row, int col);
+
+    /**
+     * Gets a board with every cell set.
+     * @return Full board.
+     */
+    static Bitboard Full();
+
+    /**
+     * Gets the cells of a straight run, as a ship would cover them. The run must stay on the board.
+     * @param index Bit index of the run's lowest cell (its leftmost or topmost).
+     * @param length Number of cells (1 to MAX_RUN).
+     * @param vertical Whether the run goes down a column instead of across a row.
+     * @return Cells of the run.
+     */
+    static Bitboard Run(int index, int length, bool vertical);
+
+    /**
+     * Checks if a cell is set.
+     * @param index Bit index of the cell.
+     * @return Whether or not the cell is set.
+     */
+    bool Test(int index) const;
+
+    /**
+     * Sets a cell.
+     * @param index Bit index of the cell.
+     */
+    void Set(int index);
+
+    /**
+     * Clears a cell.
+     * @param index Bit index of the cell.
+     */
+    void Reset(int index);
+
+    /**
+     * Counts the cells that are set.
+     * @return Number of set cells.
+     */
+    int Count() const;
+
+    /**
+     * Checks if any cell is set.
+     * @return Whether or not the board has a set cell.
+     */
+    bool Any() const;
+
+    /**
+     * Clears the lowest set cell and returns its index. The board must not be empty.
+     * @return Bit index of the cleared cell.
+     */
+    int PopFirst();
+
+    /**
+     * Finds the nth set cell, counting from the lowest index.
+     * @param n Number of set cells to skip; must be less than Count().
+     * @return Bit index of the cell.
+     */
+    int Select(int n) const;
+
+    /**
+     * Moves every cell one row up (toward row A). Cells in the top row fall off.
+     * @return Shifted board.
+     */
+    Bitboard ShiftNorth() const;
+
+    /**
+     * Moves every cell one column right. Cells in the last column fall off.
+     * @return Shifted board.
+     */
+    Bitboard ShiftEast() const;
+
+    /**
+     * Moves every cell one row down. Cells in the bottom row fall off.
+     * @return Shifted board.
+     */
+    Bitboard ShiftSouth() const;
+
+    /**
+     * Moves every cell one column left. Cells in the first column fall off.
+     * @return Shifted board.
+     */
+    Bitboard ShiftWest() const;
+
+    Bitboard operator&(const Bitboard& other) const;
+    Bitboard operator|(const Bitboard& other) const;
+    Bitboard operator^(const Bitboard& other) const;
+    Bitboard operator~() const;
+    Bitboard& operator&=(const Bitboard& other);
+    Bitboard& operator|=(const Bitboard& other);
+    bool operator==(const Bitboard& other) const;
+    bool operator!=(const Bitboard& other) const;
+private:
+    static const uint64_t HIGH_MASK = (uint64_t(1) << (NUM_CELLS - 64)) - 1;
+    static const uint64_t FIRST_COL_LOW = 0x1004010040100401ULL; // Cells 0, 10, ..., 60
+    static const uint64_t FIRST_COL_HIGH = 0x4010040ULL; // Cells 70, 80, 90
+    static const uint64_t LAST_COL_LOW = FIRST_COL_LOW << (SIZE - 1); // Cells 9, 19, ..., 59
+    static const uint64_t LAST_COL_HIGH = (FIRST_COL_HIGH << (SIZE - 1)) | (FIRST_COL_LOW >> (64 - SIZE + 1)); // Cells 69, 79, 89, 99
+
+    uint64_t low;
+    uint64_t high;
+
+    /**
+     * Shifts the 128-bit value toward higher indices.
+     * @param amount Number of bits (1-63).
+     */
+    Bitboard ShiftUp(int amount) const;
+
+    /**
+     * Shifts the 128-bit value toward lower indices.
+     * @param amount Number of bits (1-63).
+     */
+    Bitboard ShiftDown(int amount) const;
+};
+
+inline Bitboard::Bitboard() : low(0), high(0) {}
+
+inline Bitboard::Bitboard(uint64_t lowBits, uint64_t highBits) : low(lowBits), high(highBits & HIGH_MASK) {}
+
+inline int Bitboard::Index(int row, int col) {
+    return row * SIZE + col;
+}
+
+inline Bitboard Bitboard::Full() {
+    return Bitboard(~uint64_t(0), HIGH_MASK);
+}
+
+inline Bitboard Bitboard::Run(int index, int length, bool vertical) {
+    // Build the run at cell 0 in one word, then shift it to its first cell.
+    uint64_t pattern = vertical ? FIRST_COL_LOW & ((uint64_t(1) << ((length - 1) * SIZE + 1)) - 1)
+                                : (uint64_t(1) << length) - 1;
+
+    if (index >= 64) {
+        return Bitboard(0, pattern << (index - 64));
+    } else if (index == 0) {
+        return Bitboard(pattern, 0);
+    }
+
+    return Bitboard(pattern << index, pattern >> (64 - index));
+}
+
+inline bool Bitboard::Test(int index) const {
+    return (index < 64) ? ((low >> index) & 1) : ((high >> (index - 64)) & 1);
+}
+
+inline void Bitboard::Set(int index) {
+    (index < 64) ? low |= (uint64_t(1) << index) : high |= (uint64_t(1) << (index - 64));
+}
+
+inline void Bitboard::Reset(int index) {
+    (index < 64) ? low &= ~(uint64_t(1) << index) : high &= ~(uint64_t(1) << (index - 64));
+}
+
+inline int Bitboard::Count() const {
+    return __builtin_popcountll(low) + __builtin_popcountll(high);
+}
+
+inline bool Bitboard::Any() const {
+    return (low | high) != 0;
+}
+
+inline int Bitboard::PopFirst() {
+    if (low != 0) {
+        int index = __builtin_ctzll(low);
+        low &= low - 1;
+        return index;
+    }
+
+    int index = __builtin_ctzll(high) + 64;
+    high &= high - 1;
+    return index;
+}
+
+inline int Bitboard::Select(int n) const {
+    uint64_t word = low;
+    int offset = 0;
+    int lowCount = __builtin_popcountll(low);
+
+    if (n >= lowCount) {
+        word = high;
+        offset = 64;
+        n -= lowCount;
+    }
+
+    for (int i = 0; i < n; i++) { // Drop the lowest set bits that come before it
+        word &= word - 1;
+    }
+
+    return __builtin_ctzll(word) + offset;
+}
+
+inline Bitboard Bitboard::ShiftUp(int amount) const {
+    return Bitboard(low << amount, (high << amount) | (low >> (64 - amount)));
+}
+
+inline Bitboard Bitboard::ShiftDown(int amount) const {
+    return Bitboard((low >> amount) | (high << (64 - amount)), high >> amount);
+}
+
+inline Bitboard Bitboard::ShiftNorth() const {
+    return ShiftDown(SIZE);
+}
+
+inline Bitboard Bitboard::ShiftEast() const {
+    Bitboard shifted = ShiftUp(1); // Cells from the last column wrap into the next row's first column
+    return Bitboard(shifted.low & ~FIRST_COL_LOW, shifted.high & ~FIRST_COL_HIGH);
+}
+
+inline Bitboard Bitboard::ShiftSouth() const {
+    return ShiftUp(SIZE);
+}
+
+inline Bitboard Bitboard::ShiftWest() const {
+    Bitboard shifted = ShiftDown(1);
+    return Bitboard(shifted.low & ~LAST_COL_LOW, shifted.high & ~LAST_COL_HIGH);
+}
+
+inline Bitboard Bitboard::operator&(const Bitboard& other) const {
+    return Bitboard(low & other.low, high & other.high);
+}
+
+inline Bitboard Bitboard::operator|(const Bitboard& other) const {
+    return Bitboard(low | other.low, high | other.high);
+}
+
+inline Bitboard Bitboard::operator^(const Bitboard& other) const {
+    return Bitboard(low ^ other.low, high ^ other.high);
+}
+
+inline Bitboard Bitboard::operator~() const {
+    return Bitboard(~low, ~high);
+}
+
+inline Bitboard& Bitboard::operator&=(const Bitboard& other) {
+    low &= other.low;
+    high &= other.high;
+    return *this;
+}
+
+inline Bitboard& Bitboard::operator|=(const Bitboard& other) {
+    low |= other.low;
+    high |= other.high;
+    return *this;
+}
+
+inline bool Bitboard::operator==(const Bitboard& other) const {
+    return low == other.low && high == other.high;
+}
+
+inline bool Bitboard::operator!=(const Bitboard& other) const {
+    return !(*this == other);
+}
+
+#endif
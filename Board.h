@@ -0,0 +1,113 @@
+#ifndef BOARD_H
+#define BOARD_H
+#include "Bitboard.h"
+using namespace std;
+
+/**
+ * A battleship grid stored as one bitboard plane per cell state.
+ * Each cell is set in at most one plane; a cell set in no plane is empty.
+ */
+class Board {
+public:
+    static const int TEMP_INT = -2;
+    static const int NOTHING_INT = -1;
+    static const int MISS_INT = 0;
+    static const int HIT_INT = 1;
+    static const int SHIP_INT = 2;
+    static const int SUNKEN_INT = 3;
+
+    /**
+     * Gets the state of a cell.
+     * @param row Row of coordinate.
+     * @param col Column of coordinate.
+     * @return One of the *_INT values.
+     */
+    int Get(int row, int col) const;
+
+    /**
+     * Sets the state of a cell, replacing its previous state.
+     * @param row Row of coordinate.
+     * @param col Column of coordinate.
+     * @param value One of the *_INT values.
+     */
+    void Set(int row, int col, int value);
+
+    /**
+     * Checks if a cell has nothing on it.
+     * @param row Row of coordinate.
+     * @param col Column of coordinate.
+     * @return Whether or not the cell is empty.
+     */
+    bool IsEmpty(int row, int col) const;
+
+    /**
+     * Gets all cells in a particular state.
+     * @param value One of the *_INT values other than NOTHING_INT.
+     * @return Plane of cells in that state.
+     */
+    const Bitboard& GetPlane(int value) const;
+
+    /**
+     * Gets all cells that have nothing on them.
+     * @return Plane of empty cells.
+     */
+    Bitboard GetEmpty() const;
+
+    /**
+     * Sets every cell in a particular state back to nothing.
+     * @param value One of the *_INT values other than NOTHING_INT.
+     */
+    void ClearPlane(int value);
+private:
+    static const int NUM_PLANES = SUNKEN_INT - TEMP_INT + 1;
+
+    Bitboard planes[NUM_PLANES]; // Indexed by value - TEMP_INT; NOTHING_INT's plane stays empty
+};
+
+inline int Board::Get(int row, int col) const {
+    int index = Bitboard::Index(row, col);
+
+    for (int i = 0; i < NUM_PLANES; i++) {
+        if (planes[i].Test(index)) {
+            return i + TEMP_INT;
+        }
+    }
+
+    return NOTHING_INT;
+}
+
+inline void Board::Set(int row, int col, int value) {
+    int index = Bitboard::Index(row, col);
+
+    for (int i = 0; i < NUM_PLANES; i++) {
+        planes[i].Reset(index);
+    }
+
+    if (value != NOTHING_INT) {
+        planes[value - TEMP_INT].Set(index);
+    }
+}
+
+inline bool Board::IsEmpty(int row, int col) const {
+    return GetEmpty().Test(Bitboard::Index(row, col));
+}
+
+inline const Bitboard& Board::GetPlane(int value) const {
+    return planes[value - TEMP_INT];
+}
+
+inline Bitboard Board::GetEmpty() const {
+    Bitboard occupied;
+
+    for (int i = 0; i < NUM_PLANES; i++) {
+        occupied |= planes[i];
+    }
+
+    return ~occupied;
+}
+
+inline void Board::ClearPlane(int value) {
+    planes[value - TEMP_INT] = Bitboard();
+}
+
+#endif
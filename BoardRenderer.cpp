@@ -0,0 +1,291 @@
+#include "BoardRenderer.h"
+#include "Board.h"
+#include <iostream>
+#include <string>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <sys/ioctl.h>
+#include <unistd.h>
+using namespace std;
+
+BoardRenderer& BoardRenderer::Get() {
+    static BoardRenderer renderer;
+    return renderer;
+}
+
+BoardRenderer::BoardRenderer() {
+    used = 0;
+    framed = false;
+    pinned = false;
+    screenHeight = 0;
+    memset(shown, 0, sizeof(shown));
+
+    const char* term = getenv("TERM");
+    struct winsize window;
+
+    if (isatty(STDOUT_FILENO) && term != nullptr && strcmp(term, "dumb") != 0 &&
+        ioctl(STDOUT_FILENO, TIOCGWINSZ, &window) == 0) {
+        pinned = window.ws_col >= NUM_SLOTS * BOARD_WIDTH + SLOT_GAP &&
+                 window.ws_row >= PINNED_HEIGHT + MIN_SCROLL_HEIGHT;
+        screenHeight = window.ws_row;
+    }
+}
+
+BoardRenderer::~BoardRenderer() {
+    if (!framed) {
+        return;
+    }
+
+    cout.flush();
+    AppendText("\x1b[r", 3); // Scroll the whole screen again
+    AppendCursor(screenHeight, 1);
+    AppendText("\n", 1);
+    WriteFrame();
+}
+
+void BoardRenderer::Draw(int slot, const Board& board, const string& description, const string& status) {
+    cout.flush();
+
+    if (!pinned) {
+        AppendPlain(board, description, status);
+        WriteFrame();
+        return;
+    }
+
+    if (!framed) {
+        DrawFrame();
+    }
+
+    const int CELL_OFFSET = ROW_START_WIDTH + GRID_SPACING;
+    const int CELL_SPACING = GRID_SPACING + 1;
+    const int FIRST_ROW_LINE = 4; // Under the title, bar and numbers
+
+    int column = GetSlotColumn(slot);
+    AppendText("\x1b" "7", 2); // Save the cursor of the text below
+
+    string title = description + "\n" + status;
+
+    if (title != shownTitles[slot]) {
+        // Cut a long description short so it never runs into the other board.
+        int room = BOARD_WIDTH - static_cast<int>(status.length()) - 1;
+        string shortDescription = (room > 0) ? description.substr(0, room) : "";
+        AppendCursor(1, column);
+        AppendRepeat(' ', BOARD_WIDTH);
+        AppendCursor(1, column);
+        AppendTitle(shortDescription, status);
+        shownTitles[slot] = title;
+    }
+
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            char marker = GetMarker(board.Get(row, col));
+            char& onScreen = shown[slot][row * SIZE + col];
+
+            if (marker != onScreen) {
+                AppendCursor(FIRST_ROW_LINE + row, column + CELL_OFFSET + CELL_SPACING * col);
+                AppendText(&marker, 1);
+                onScreen = marker;
+            }
+        }
+    }
+
+    AppendText("\x1b" "8", 2);
+    WriteFrame();
+}
+
+bool BoardRenderer::IsPinned() const {
+    return pinned;
+}
+
+void BoardRenderer::DrawFrame() {
+    const char NOTHING_MARKER = GetMarker(Board::NOTHING_INT);
+
+    AppendText("\x1b[2J", 4); // Clear the screen
+
+    for (int slot = 0; slot < NUM_SLOTS; slot++) {
+        int column = GetSlotColumn(slot);
+        int line = 2; // The title line stays blank until the slot is drawn
+
+        AppendCursor(line++, column);
+        AppendBar();
+        AppendCursor(line++, column);
+        AppendNumbers();
+
+        for (int row = 0; row < SIZE; row++) {
+            AppendCursor(line++, column);
+            AppendRowStart(row);
+
+            for (int col = 0; col < SIZE; col++) {
+                AppendRepeat(' ', GRID_SPACING);
+                AppendText(&NOTHING_MARKER, 1);
+                shown[slot][row * SIZE + col] = NOTHING_MARKER;
+            }
+
+            AppendRepeat(' ', ROW_PADDING);
+            AppendText("|", 1);
+        }
+
+        AppendCursor(line, column);
+        AppendBar();
+    }
+
+    // Keep text scrolling under the boards; setting the region homes the cursor, so put it back under them.
+    AppendText("\x1b[", 2);
+    AppendNumber(PINNED_HEIGHT + 1);
+    AppendText(";", 1);
+    AppendNumber(screenHeight);
+    AppendText("r", 1);
+    AppendCursor(PINNED_HEIGHT + 1, 1);
+    framed = true;
+}
+
+void BoardRenderer::AppendPlain(const Board& board, const string& description, const string& status) {
+    AppendText("\n\n", 2);
+    AppendRepeat(' ', PLAIN_PADDING);
+    AppendTitle(description, status);
+    AppendText("\n", 1);
+    AppendRepeat(' ', PLAIN_PADDING);
+    AppendBar();
+    AppendText("\n", 1);
+    AppendRepeat(' ', PLAIN_PADDING);
+    AppendNumbers();
+    AppendText("\n", 1);
+
+    for (int row = 0; row < SIZE; row++) {
+        AppendRepeat(' ', PLAIN_PADDING);
+        AppendRowStart(row);
+
+        for (int col = 0; col < SIZE; col++) {
+            char marker = GetMarker(board.Get(row, col));
+            AppendRepeat(' ', GRID_SPACING);
+            AppendText(&marker, 1);
+        }
+
+        AppendRepeat(' ', ROW_PADDING);
+        AppendText("|\n", 2);
+    }
+
+    AppendRepeat(' ', PLAIN_PADDING);
+    AppendBar();
+    AppendText("\n\n", 2);
+}
+
+void BoardRenderer::AppendTitle(const string& description, const string& status) {
+    AppendText(description);
+    AppendRepeat(' ', BOARD_WIDTH - static_cast<int>(status.length()) - static_cast<int>(description.length()));
+    AppendText(status);
+}
+
+void BoardRenderer::AppendBar() {
+    AppendRepeat('-', BOARD_WIDTH);
+}
+
+void BoardRenderer::AppendNumbers() {
+    const int NUMBER_OFFSET_L = 4;
+    const int NUMBER_SPACING = 2;
+
+    AppendText("|", 1);
+    AppendRepeat(' ', NUMBER_OFFSET_L);
+
+    for (int i = 1; i <= SIZE; i++) {
+        AppendNumber(i);
+        AppendRepeat(' ', NUMBER_SPACING);
+    }
+
+    AppendText("|", 1);
+}
+
+void BoardRenderer::AppendRowStart(int row) {
+    char letter = static_cast<char>('A' + row);
+    AppendText("| ", 2);
+    AppendText(&letter, 1);
+}
+
+void BoardRenderer::AppendCursor(int line, int column) {
+    AppendText("\x1b[", 2);
+    AppendNumber(line);
+    AppendText(";", 1);
+    AppendNumber(column);
+    AppendText("H", 1);
+}
+
+void BoardRenderer::AppendText(const char* text, int length) {
+    if (length > FRAME_CAPACITY - used) {
+        length = FRAME_CAPACITY - used;
+    }
+
+    memcpy(frame + used, text, length);
+    used += length;
+}
+
+void BoardRenderer::AppendText(const string& text) {
+    AppendText(text.data(), static_cast<int>(text.length()));
+}
+
+void BoardRenderer::AppendRepeat(char character, int count) {
+    if (count > FRAME_CAPACITY - used) {
+        count = FRAME_CAPACITY - used;
+    }
+
+    if (count > 0) {
+        memset(frame + used, character, count);
+        used += count;
+    }
+}
+
+void BoardRenderer::AppendNumber(int number) {
+    char digits[12];
+    int length = 0;
+
+    do {
+        digits[sizeof(digits) - 1 - length] = static_cast<char>('0' + number % 10);
+        number /= 10;
+        length++;
+    } while (number > 0);
+
+    AppendText(digits + sizeof(digits) - length, length);
+}
+
+void BoardRenderer::WriteFrame() {
+    int written = 0;
+
+    // A terminal takes the whole frame at once; only a signal or a full pipe splits it.
+    while (written < used) {
+        ssize_t result = write(STDOUT_FILENO, frame + written, used - written);
+
+        if (result < 0 && errno != EINTR) {
+            break;
+        }
+
+        if (result > 0) {
+            written += result;
+        }
+    }
+
+    used = 0;
+}
+
+char BoardRenderer::GetMarker(int value) {
+    const char NOTHING_MARKER = '*';
+    const char MISS_MARKER = '-';
+    const char HIT_MARKER = 'x';
+    const char SHIP_MARKER = 'O';
+    const char SUNKEN_MARKER = '~';
+
+    if (value == Board::MISS_INT) {
+        return MISS_MARKER;
+    } else if (value == Board::HIT_INT) {
+        return HIT_MARKER;
+    } else if (value == Board::SHIP_INT) {
+        return SHIP_MARKER;
+    } else if (value == Board::SUNKEN_INT) {
+        return SUNKEN_MARKER;
+    }
+
+    return NOTHING_MARKER;
+}
+
+int BoardRenderer::GetSlotColumn(int slot) {
+    return 1 + slot * (BOARD_WIDTH + SLOT_GAP);
+}
@@ -0,0 +1,160 @@
+#ifndef BOARD_RENDERER_H
+#define BOARD_RENDERER_H
+#include "Board.h"
+#include "Bitboard.h"
+#include <string>
+using namespace std;
+
+/**
+ * Draws boards for the console game, building each frame in one preallocated buffer and writing it with one write().
+ * On a terminal that is big enough, the ships and shots boards are pinned side by side at the top of the screen, text
+ * scrolls in the region below them, and each frame only redraws the cells and titles that changed since the last one.
+ * Anywhere else (a pipe, a file, TERM=dumb or a small window) every frame is a full board in plain text.
+ */
+class BoardRenderer {
+public:
+    static const int NUM_SLOTS = 2; // Where a board is pinned: SHIPS_SLOT on the left, SHOTS_SLOT on the right
+    static const int SHIPS_SLOT = 0;
+    static const int SHOTS_SLOT = 1;
+
+    /**
+     * Gets the renderer of the standard output, setting it up the first time.
+     * @return The renderer.
+     */
+    static BoardRenderer& Get();
+
+    BoardRenderer(const BoardRenderer&) = delete;
+    BoardRenderer& operator=(const BoardRenderer&) = delete;
+
+    /**
+     * Gives the terminal its whole screen back if boards were pinned.
+     */
+    ~BoardRenderer();
+
+    /**
+     * Draws a board. Anything waiting in cout is written first so the output stays in order.
+     * @param slot SHIPS_SLOT or SHOTS_SLOT.
+     * @param board The board to draw.
+     * @param description Title on the left above the board.
+     * @param status Text on the right above the board.
+     */
+    void Draw(int slot, const Board& board, const string& description, const string& status);
+
+    /**
+     * Checks if boards are pinned and redrawn in place.
+     * @return Whether or not ANSI drawing is in use.
+     */
+    bool IsPinned() const;
+private:
+    static const int FRAME_CAPACITY = 1 << 14; // Larger than a full redraw of both slots
+    static const int SIZE = Bitboard::SIZE;
+    static const int BOARD_WIDTH = 37; // Sides included
+    static const int BOARD_HEIGHT = 14; // Title, bar, numbers, rows and bar
+    static const int GRID_SPACING = 2; // Spaces before each cell
+    static const int ROW_START_WIDTH = 3; // Side, space and letter before the cells of a row
+    static const int ROW_PADDING = BOARD_WIDTH - ROW_START_WIDTH - (GRID_SPACING + 1) * SIZE - 1; // Spaces before the right side
+    static const int SLOT_GAP = 4;
+    static const int PINNED_HEIGHT = BOARD_HEIGHT + 1; // Boards and a blank line under them
+    static const int MIN_SCROLL_HEIGHT = 6; // Lines left for text below the boards
+    static const int PLAIN_PADDING = 15; // Indent of plain boards
+
+    char frame[FRAME_CAPACITY];
+    int used;
+    bool pinned;
+    bool framed; // Whether the empty boards and scroll region have been drawn
+    int screenHeight;
+    char shown[NUM_SLOTS][SIZE * SIZE]; // Marker on screen for every cell of each slot, or 0 if none yet
+    string shownTitles[NUM_SLOTS];
+
+    BoardRenderer();
+
+    /**
+     * Draws the empty boards of both slots and limits scrolling to the lines under them.
+     */
+    void DrawFrame();
+
+    /**
+     * Adds one board in plain text, laid out the way the console game always has.
+     * @param board The board to draw.
+     * @param description Title on the left above the board.
+     * @param status Text on the right above the board.
+     */
+    void AppendPlain(const Board& board, const string& description, const string& status);
+
+    /**
+     * Adds the title line of a board: the description, padded so that the status ends at the board's right side.
+     * @param description Title on the left.
+     * @param status Text on the right.
+     */
+    void AppendTitle(const string& description, const string& status);
+
+    /**
+     * Adds the bar above or below a board.
+     */
+    void AppendBar();
+
+    /**
+     * Adds the line of column numbers, between the sides of the board.
+     */
+    void AppendNumbers();
+
+    /**
+     * Adds the left side and letter of a row, up to its first cell.
+     * @param row Row of the board.
+     */
+    void AppendRowStart(int row);
+
+    /**
+     * Adds a move of the cursor.
+     * @param line Line of the screen, from 1.
+     * @param column Column of the screen, from 1.
+     */
+    void AppendCursor(int line, int column);
+
+    /**
+     * Adds text to the frame. Text that doesn't fit in the frame is dropped.
+     * @param text The text.
+     * @param length Number of characters.
+     */
+    void AppendText(const char* text, int length);
+
+    /**
+     * Adds text to the frame.
+     * @param text The text.
+     */
+    void AppendText(const string& text);
+
+    /**
+     * Adds a character a number of times.
+     * @param character The character.
+     * @param count Number of times.
+     */
+    void AppendRepeat(char character, int count);
+
+    /**
+     * Adds a non-negative number in decimal.
+     * @param number The number.
+     */
+    void AppendNumber(int number);
+
+    /**
+     * Writes out the frame and empties the buffer.
+     */
+    void WriteFrame();
+
+    /**
+     * Gets the character a cell is drawn with.
+     * @param value Value of the cell on its board.
+     * @return Marker of the cell.
+     */
+    static char GetMarker(int value);
+
+    /**
+     * Gets the screen column where a slot's board starts.
+     * @param slot SHIPS_SLOT or SHOTS_SLOT.
+     * @return Column of the board's left side, from 1.
+     */
+    static int GetSlotColumn(int slot);
+};
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef COORD_H
+#define COORD_H
+#include "Bitboard.h"
+#include <cstdint>
+#include <type_traits>
+using namespace std;
+
+/**
+ * A row and column on the grid, packed into two bytes so it can be passed and stored by value.
+ * Either part may be off the board (a search can step past an edge), so check IsOnBoard before using GetIndex.
+ */
+struct Coord {
+    int8_t row;
+    int8_t col;
+
+    Coord();
+    Coord(int coordRow, int coordCol);
+
+    /**
+     * Makes the coordinate of a bit index.
+     * @param index Bit index of the cell.
+     * @return Coordinate of the cell.
+     */
+    static Coord FromIndex(int index);
+
+    /**
+     * Converts the coordinate into a bit index.
+     * @return Bit index of the cell.
+     */
+    int GetIndex() const;
+
+    /**
+     * Checks if the coordinate is within the grid.
+     * @return Whether or not the coordinate is on the board.
+     */
+    bool IsOnBoard() const;
+
+    bool operator==(const Coord& other) const;
+    bool operator!=(const Coord& other) const;
+};
+
+static_assert(is_trivially_copyable<Coord>::value && sizeof(Coord) == 2, "Coord must stay two plain bytes");
+
+inline Coord::Coord() : row(0), col(0) {}
+
+inline Coord::Coord(int coordRow, int coordCol) : row(static_cast<int8_t>(coordRow)), col(static_cast<int8_t>(coordCol)) {}
+
+inline Coord Coord::FromIndex(int index) {
+    return Coord(index / Bitboard::SIZE, index % Bitboard::SIZE);
+}
+
+inline int Coord::GetIndex() const {
+    return Bitboard::Index(row, col);
+}
+
+inline bool Coord::IsOnBoard() const {
+    return row >= 0 && row < Bitboard::SIZE && col >= 0 && col < Bitboard::SIZE;
+}
+
+inline bool Coord::operator==(const Coord& other) const {
+    return row == other.row && col == other.col;
+}
+
+inline bool Coord::operator!=(const Coord& other) const {
+    return !(*this == other);
+}
+
+#endif
@@ -0,0 +1,173 @@
+#include "DensityMap.h"
+#include "Placement.h"
+#include <cstring>
+using namespace std;
+
+/**
+ * Every placement of every ship length, and which of them cover each cell. Built once and shared by all maps.
+ */
+struct PlacementTable {
+    static const int MIN_LENGTH = Ship::DESTROYER_HP;
+    static const int MAX_LENGTH = Placement::MAX_LENGTH;
+    static const int MAX_COVERING = 2 * MAX_LENGTH; // A cell is covered by at most length placements per axis
+
+    int numPlacements[MAX_LENGTH + 1];
+    unsigned char cells[MAX_LENGTH + 1][DensityMap::MAX_PLACEMENTS][MAX_LENGTH];
+    int numCovering[MAX_LENGTH + 1][Bitboard::NUM_CELLS];
+    unsigned char covering[MAX_LENGTH + 1][Bitboard::NUM_CELLS][MAX_COVERING];
+
+    PlacementTable() {
+        const int SIZE = Bitboard::SIZE;
+
+        memset(numPlacements, 0, sizeof(numPlacements));
+        memset(numCovering, 0, sizeof(numCovering));
+
+        for (int length = MIN_LENGTH; length <= MAX_LENGTH; length++) {
+            for (int vertical = 0; vertical <= 1; vertical++) {
+                int step = vertical ? SIZE : 1;
+                int maxRow = vertical ? SIZE - length : SIZE - 1;
+                int maxCol = vertical ? SIZE - 1 : SIZE - length;
+
+                for (int row = 0; row <= maxRow; row++) {
+                    for (int col = 0; col <= maxCol; col++) {
+                        int placement = numPlacements[length]++;
+
+                        for (int i = 0; i < length; i++) {
+                            int index = Bitboard::Index(row, col) + i * step;
+                            cells[length][placement][i] = index;
+                            covering[length][index][numCovering[length][index]++] = placement;
+                        }
+                    }
+                }
+            }
+        }
+    }
+};
+
+/**
+ * Gets the shared placement table, building it on first use.
+ * @return The table.
+ */
+static const PlacementTable& GetTable() {
+    static const PlacementTable table;
+    return table;
+}
+
+DensityMap::DensityMap() {
+    numShips = 0;
+    afloat = 0;
+    memset(cellCount, 0, sizeof(cellCount));
+    memset(cellHits, 0, sizeof(cellHits));
+}
+
+void DensityMap::Reset(const int shipLengths[], int numShips) {
+    const PlacementTable& table = GetTable();
+
+    this->numShips = numShips;
+    afloat = (1u << numShips) - 1;
+    memset(legal, true, sizeof(legal));
+    memset(placementHits, 0, sizeof(placementHits));
+    memset(cellCount, 0, sizeof(cellCount));
+    memset(cellHits, 0, sizeof(cellHits));
+
+    for (int ship = 0; ship < numShips; ship++) {
+        lengths[ship] = shipLengths[ship];
+
+        for (int i = 0; i < NUM_CELLS; i++) {
+            cellCount[i] += table.numCovering[lengths[ship]][i];
+        }
+    }
+}
+
+void DensityMap::RemovePlacement(int shipId, int placement) {
+    if (!legal[shipId][placement]) {
+        return;
+    }
+
+    const unsigned char* cells = GetTable().cells[lengths[shipId]][placement];
+    int hits = placementHits[shipId][placement];
+    legal[shipId][placement] = false;
+
+    for (int i = 0; i < lengths[shipId]; i++) {
+        cellCount[cells[i]]--;
+        cellHits[cells[i]] -= hits;
+    }
+}
+
+void DensityMap::AddMiss(int index) {
+    const PlacementTable& table = GetTable();
+
+    for (int ship = 0; ship < numShips; ship++) {
+        if ((afloat & (1u << ship)) == 0) {
+            continue;
+        }
+
+        int length = lengths[ship];
+
+        for (int i = 0; i < table.numCovering[length][index]; i++) {
+            RemovePlacement(ship, table.covering[length][index][i]);
+        }
+    }
+}
+
+void DensityMap::AddHit(int index) {
+    const PlacementTable& table = GetTable();
+
+    for (int ship = 0; ship < numShips; ship++) {
+        if ((afloat & (1u << ship)) == 0) {
+            continue;
+        }
+
+        int length = lengths[ship];
+
+        for (int i = 0; i < table.numCovering[length][index]; i++) {
+            int placement = table.covering[length][index][i];
+
+            if (!legal[ship][placement]) {
+                continue;
+            }
+
+            const unsigned char* cells = table.cells[length][placement];
+            placementHits[ship][placement]++;
+
+            for (int j = 0; j < length; j++) {
+                cellHits[cells[j]]++;
+            }
+        }
+    }
+}
+
+void DensityMap::AddSunk(int shipId, Bitboard cells) {
+    const PlacementTable& table = GetTable();
+
+    for (int i = 0; i < table.numPlacements[lengths[shipId]]; i++) {
+        RemovePlacement(shipId, i);
+    }
+
+    afloat &= ~(1u << shipId);
+
+    while (cells.Any()) { // The wreck now blocks the other ships like a miss would
+        AddMiss(cells.PopFirst());
+    }
+}
+
+Bitboard DensityMap::GetDensestCells(Bitboard targets) const {
+    Bitboard best;
+    int bestScore = -1;
+
+    while (targets.Any()) {
+        int index = targets.PopFirst();
+        int score = (cellHits[index] << COUNT_BITS) | cellCount[index];
+
+        if (score > bestScore) {
+            bestScore = score;
+            best = Bitboard();
+        }
+
+        if (score == bestScore) {
+            best.Set(index);
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,70 @@
+#ifndef DENSITY_MAP_H
+#define DENSITY_MAP_H
+#include "Bitboard.h"
+using namespace std;
+
+/**
+ * Keeps count of how many legal placements of each remaining ship cover every cell, updated one shot at a time.
+ * A shot only changes the placements that cross its cell, so nothing is recounted from scratch between shots.
+ */
+class DensityMap {
+public:
+    static const int MAX_SHIPS = 5;
+    static const int MAX_PLACEMENTS = 2 * Bitboard::SIZE * (Bitboard::SIZE - 1); // Placements of the shortest ship (a destroyer)
+
+    DensityMap();
+
+    /**
+     * Starts over with every placement of every ship legal.
+     * @param shipLengths Length of each ship, indexed by ship id.
+     * @param numShips Number of entries in shipLengths; at most MAX_SHIPS.
+     */
+    void Reset(const int shipLengths[], int numShips);
+
+    /**
+     * Rules out every placement that covers a missed cell.
+     * @param index Cell of the miss.
+     */
+    void AddMiss(int index);
+
+    /**
+     * Gives extra weight to every placement that covers a hit cell.
+     * @param index Cell of the hit.
+     */
+    void AddHit(int index);
+
+    /**
+     * Removes a sunken ship and rules out every placement of the other ships that crosses its cells.
+     * @param shipId The ship that sank.
+     * @param cells Cells the ship was on.
+     */
+    void AddSunk(int shipId, Bitboard cells);
+
+    /**
+     * Finds the cells covered by the most legal placements. Covering unsunk hits outranks everything else, so
+     * placements are weighted by the hits they cover before the plain count is compared.
+     * @param targets Cells that may be picked.
+     * @return The targets tied for the highest density (empty only if targets is).
+     */
+    Bitboard GetDensestCells(Bitboard targets) const;
+private:
+    static const int NUM_CELLS = Bitboard::NUM_CELLS;
+    static const int COUNT_BITS = 6; // Each cell is covered by at most 2 * (2 + 3 + 3 + 4 + 5) = 34 placements
+
+    int lengths[MAX_SHIPS];
+    int numShips;
+    unsigned int afloat; // Bit i is set while ship i is still afloat
+    bool legal[MAX_SHIPS][MAX_PLACEMENTS];
+    unsigned char placementHits[MAX_SHIPS][MAX_PLACEMENTS]; // Hits each placement covers
+    unsigned char cellCount[NUM_CELLS]; // Legal placements covering each cell
+    unsigned char cellHits[NUM_CELLS]; // Sum of placementHits over the legal placements covering each cell
+
+    /**
+     * Rules out one placement if it is still legal.
+     * @param shipId Ship of the placement.
+     * @param placement Index of the placement among those of the ship's length.
+     */
+    void RemovePlacement(int shipId, int placement);
+};
+
+#endif
@@ -0,0 +1,312 @@
+#include "FleetSampler.h"
+#include "Placement.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+#include <chrono>
+#include <utility>
+using namespace std;
+
+/**
+ * Everything the threads sampling for one shot share. Streams are handed out in order through nextStream.
+ */
+struct FleetSampler::Job {
+    const int* lengths;
+    int numShips;
+    Bitboard blocked;
+    Bitboard hits;
+    int samples;
+    int streams;
+    int microseconds;
+    uint64_t seed;
+    chrono::steady_clock::time_point deadline;
+    atomic<int> nextStream;
+};
+
+/**
+ * Worker threads that help the calling thread run a job's streams. Each worker keeps its own counts, and the caller
+ * merges them once every worker is done. A caller that finds the pool in use by another thread samples alone.
+ */
+class FleetSampler::WorkerPool {
+public:
+    /**
+     * Gets the pool, starting its workers the first time.
+     * @return The pool.
+     */
+    static WorkerPool& Get();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * Stops and joins the workers.
+     */
+    ~WorkerPool();
+
+    /**
+     * Runs every stream of a job, on the calling thread and as many workers as there are streams left for.
+     * @param job The job.
+     * @param counts Receives the count of every cell; must hold Bitboard::NUM_CELLS entries.
+     * @return Number of layouts that fit.
+     */
+    int Run(Job& job, int counts[]);
+private:
+    /**
+     * One worker's counts, kept on its own cache lines.
+     */
+    struct alignas(64) Slot {
+        int counts[Bitboard::NUM_CELLS];
+        int accepted;
+    };
+
+    vector<thread> workers;
+    vector<Slot> slots;
+    mutex busy; // Held by the thread whose job the workers are running
+    mutex jobMutex; // Guards everything below
+    condition_variable wake;
+    condition_variable done;
+    Job* current;
+    int numHelping; // Workers taking part in the current job
+    int running; // Workers still taking part in the current job
+    unsigned long long generation; // Number of jobs started
+    bool stopping;
+
+    WorkerPool();
+
+    /**
+     * Waits for jobs and helps run them until the pool stops.
+     * @param worker Number of the worker.
+     */
+    void Work(int worker);
+};
+
+FleetSampler::WorkerPool& FleetSampler::WorkerPool::Get() {
+    static WorkerPool pool;
+    return pool;
+}
+
+FleetSampler::WorkerPool::WorkerPool() {
+    current = nullptr;
+    numHelping = 0;
+    running = 0;
+    generation = 0;
+    stopping = false;
+
+    // The calling thread samples too, so one core is left for it.
+    int numWorkers = static_cast<int>(thread::hardware_concurrency()) - 1;
+
+    if (numWorkers > MAX_STREAMS - 1) {
+        numWorkers = MAX_STREAMS - 1;
+    }
+
+    if (numWorkers > 0) {
+        slots.resize(numWorkers);
+
+        for (int i = 0; i < numWorkers; i++) {
+            workers.push_back(thread(&WorkerPool::Work, this, i));
+        }
+    }
+}
+
+FleetSampler::WorkerPool::~WorkerPool() {
+    {
+        lock_guard<mutex> lock(jobMutex);
+        stopping = true;
+    }
+
+    wake.notify_all();
+
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+int FleetSampler::WorkerPool::Run(Job& job, int counts[]) {
+    const int NUM_CELLS = Bitboard::NUM_CELLS;
+
+    unique_lock<mutex> busyLock(busy, try_to_lock);
+    int helpers = job.streams - 1;
+
+    if (helpers > static_cast<int>(workers.size())) {
+        helpers = static_cast<int>(workers.size());
+    }
+
+    if (!busyLock.owns_lock() || helpers <= 0) {
+        return RunStreams(job, counts);
+    }
+
+    {
+        lock_guard<mutex> lock(jobMutex);
+        current = &job;
+        numHelping = helpers;
+        running = helpers;
+        generation++;
+    }
+
+    wake.notify_all();
+    int accepted = RunStreams(job, counts);
+
+    unique_lock<mutex> lock(jobMutex);
+    done.wait(lock, [this] { return running == 0; });
+
+    for (int i = 0; i < helpers; i++) {
+        accepted += slots[i].accepted;
+
+        for (int j = 0; j < NUM_CELLS; j++) {
+            counts[j] += slots[i].counts[j];
+        }
+    }
+
+    return accepted;
+}
+
+void FleetSampler::WorkerPool::Work(int worker) {
+    unsigned long long seen = 0;
+    unique_lock<mutex> lock(jobMutex);
+
+    while (true) {
+        wake.wait(lock, [&] { return stopping || generation != seen; });
+
+        if (stopping) {
+            return;
+        }
+
+        seen = generation;
+
+        if (worker >= numHelping) { // More workers than streams; this job doesn't need this one
+            continue;
+        }
+
+        Job* job = current;
+        lock.unlock();
+        slots[worker].accepted = RunStreams(*job, slots[worker].counts);
+        lock.lock();
+
+        if (--running == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+int FleetSampler::CountShips(const int lengths[], int numShips, const Bitboard& blocked, const Bitboard& hits,
+                             const Budget& budget, uint64_t seed, int counts[]) {
+    Job job;
+    job.lengths = lengths;
+    job.numShips = numShips;
+    job.blocked = blocked;
+    job.hits = hits;
+    job.samples = (budget.samples > 0) ? budget.samples : 0;
+    job.streams = budget.streams;
+    job.microseconds = budget.microseconds;
+    job.seed = seed;
+    job.deadline = chrono::steady_clock::now() + chrono::microseconds(budget.microseconds);
+    job.nextStream = 0;
+
+    if (job.streams > MAX_STREAMS) {
+        job.streams = MAX_STREAMS;
+    }
+
+    if (job.streams > job.samples) {
+        job.streams = job.samples;
+    }
+
+    if (job.streams <= 0) {
+        job.streams = 1;
+    }
+
+    return WorkerPool::Get().Run(job, counts);
+}
+
+int FleetSampler::RunStreams(Job& job, int counts[]) {
+    const int NUM_CELLS = Bitboard::NUM_CELLS;
+
+    for (int i = 0; i < NUM_CELLS; i++) {
+        counts[i] = 0;
+    }
+
+    // Whichever thread runs a stream, it draws the same layouts, so the summed counts never depend on the threads.
+    int accepted = 0;
+
+    for (int stream = job.nextStream++; stream < job.streams; stream = job.nextStream++) {
+        accepted += SampleStream(job, stream, counts);
+    }
+
+    return accepted;
+}
+
+int FleetSampler::SampleStream(const Job& job, int stream, int counts[]) {
+    const int CLOCK_INTERVAL = 64; // Attempts between looks at the clock
+
+    int quota = job.samples / job.streams + ((stream < job.samples % job.streams) ? 1 : 0);
+    long long maxAttempts = static_cast<long long>(quota) * MAX_ATTEMPTS_PER_SAMPLE;
+    Random rng(job.seed + stream);
+    int accepted = 0;
+
+    for (long long attempt = 0; accepted < quota && attempt < maxAttempts; attempt++) {
+        if (job.microseconds > 0 && attempt % CLOCK_INTERVAL == 0 && chrono::steady_clock::now() >= job.deadline) {
+            break;
+        }
+
+        Bitboard occupied;
+
+        if (!DrawLayout(job.lengths, job.numShips, job.blocked, job.hits, rng, occupied)) {
+            continue;
+        }
+
+        accepted++;
+
+        while (occupied.Any()) {
+            counts[occupied.PopFirst()]++;
+        }
+    }
+
+    return accepted;
+}
+
+bool FleetSampler::DrawLayout(const int lengths[], int numShips, const Bitboard& blocked, const Bitboard& hits,
+                              Random& rng, Bitboard& occupied) {
+    const int SIZE = Bitboard::SIZE;
+
+    occupied = Bitboard();
+    int order[MAX_SHIPS];
+
+    for (int i = 0; i < numShips; i++) { // Place the ships in a random order so no ship always gets first pick
+        int j = rng.NextInt(i + 1);
+        order[i] = i;
+        swap(order[i], order[j]);
+    }
+
+    for (int ship = 0; ship < numShips; ship++) {
+        int length = lengths[order[ship]];
+        Bitboard horizontal;
+        Bitboard vertical;
+        Placement::GetLegalAnchors(length, blocked | occupied, horizontal, vertical);
+
+        // Pick uniformly among the legal placements of both axes.
+        int numHorizontal = horizontal.Count();
+        int numPlacements = numHorizontal + vertical.Count();
+
+        if (numPlacements == 0) {
+            return false;
+        }
+
+        int pick = rng.NextInt(numPlacements);
+        int anchor = (pick < numHorizontal) ? horizontal.Select(pick) : vertical.Select(pick - numHorizontal);
+        int step = (pick < numHorizontal) ? 1 : SIZE;
+        Bitboard shipCells;
+
+        for (int i = 0; i < length; i++) {
+            shipCells.Set(anchor + i * step);
+        }
+
+        if ((shipCells & ~hits) == Bitboard()) { // Every cell already hit means the ship would have been sunk
+            return false;
+        }
+
+        occupied |= shipCells;
+    }
+
+    return (hits & ~occupied) == Bitboard();
+}
@@ -0,0 +1,83 @@
+#ifndef FLEET_SAMPLER_H
+#define FLEET_SAMPLER_H
+#include "Bitboard.h"
+#include "Random.h"
+#include <cstdint>
+using namespace std;
+
+/**
+ * Draws random fleet layouts that fit everything known about the opponent's board and counts how often each cell
+ * holds a ship. The counts estimate the chance that a shot at each cell is a hit.
+ * Layouts are drawn in a fixed number of streams, each with its own generator. The streams run on a pool of worker
+ * threads that is started the first time it is needed and kept for the rest of the program, so a shot never starts a
+ * thread or allocates.
+ */
+class FleetSampler {
+public:
+    static const int MAX_SHIPS = 5;
+
+    static const int MAX_STREAMS = 64;
+
+    /**
+     * Limits on the work done for one shot. Sampling stops at whichever limit is reached first.
+     * Without a time limit, the counts only depend on the seed, samples and streams, never on the machine.
+     */
+    struct Budget {
+        int samples = 4000; // Layouts to accept
+        int streams = 8; // Generators the samples are split between (1 to MAX_STREAMS)
+        int microseconds = 0; // Wall time, or 0 for no limit; a limit makes the counts depend on the machine's speed
+    };
+
+    /**
+     * Samples fleet layouts and counts, for every cell, how many of them put a ship there.
+     * A layout fits if every ship avoids the blocked cells and the other ships, every hit is covered, and no ship lies
+     * entirely on hits (it would have been sunk already).
+     * @param lengths Lengths of the ships that are still afloat.
+     * @param numShips Number of entries in lengths; at most MAX_SHIPS.
+     * @param blocked Cells no ship can be on (misses and sunken ships).
+     * @param hits Cells known to hold a ship that isn't sunk yet.
+     * @param budget Limits on the sampling.
+     * @param seed Seed of the samplers; stream i draws from a generator seeded with seed + i.
+     * @param counts Receives the count of every cell; must hold Bitboard::NUM_CELLS entries.
+     * @return Number of layouts that fit.
+     */
+    static int CountShips(const int lengths[], int numShips, const Bitboard& blocked, const Bitboard& hits,
+                          const Budget& budget, uint64_t seed, int counts[]);
+private:
+    static const int MAX_ATTEMPTS_PER_SAMPLE = 64; // Gives up on a stream's quota if layouts almost never fit
+
+    struct Job;
+    class WorkerPool;
+
+    /**
+     * Takes streams of a job one at a time until none are left, adding their layouts to one thread's counts.
+     * @param job The job.
+     * @param counts The thread's counts; must hold Bitboard::NUM_CELLS entries, which are cleared first.
+     * @return Number of layouts that fit.
+     */
+    static int RunStreams(Job& job, int counts[]);
+
+    /**
+     * Samples the layouts of one stream.
+     * @param job The job.
+     * @param stream Number of the stream.
+     * @param counts Counts to add to.
+     * @return Number of layouts that fit.
+     */
+    static int SampleStream(const Job& job, int stream, int counts[]);
+
+    /**
+     * Places every ship at a random legal spot, one after another.
+     * @param lengths Lengths of the ships to place.
+     * @param numShips Number of entries in lengths.
+     * @param blocked Cells no ship can be on.
+     * @param hits Cells known to hold a ship that isn't sunk yet.
+     * @param rng Generator to draw from.
+     * @param occupied Receives the cells of the whole fleet.
+     * @return Whether or not the layout fits.
+     */
+    static bool DrawLayout(const int lengths[], int numShips, const Bitboard& blocked, const Bitboard& hits,
+                           Random& rng, Bitboard& occupied);
+};
+
+#endif
@@ -0,0 +1,146 @@
+#include "GameEngine.h"
+#include "Player.h"
+#include <cstdint>
+using namespace std;
+
+GameEngine::GameEngine(const Player& first, const Player& second, uint64_t seed) : players{first, second} {
+    Start(seed);
+}
+
+void GameEngine::Reset(uint64_t seed) {
+    for (int i = 0; i < NUM_PLAYERS; i++) {
+        players[i].Reset();
+    }
+
+    Start(seed);
+}
+
+GameEngine::SavedGame GameEngine::Snapshot() const {
+    SavedGame snapshot;
+
+    for (int i = 0; i < NUM_PLAYERS; i++) {
+        snapshot.players[i] = players[i].Snapshot();
+    }
+
+    snapshot.state = state;
+    return snapshot;
+}
+
+void GameEngine::Restore(const SavedGame& snapshot) {
+    for (int i = 0; i < NUM_PLAYERS; i++) {
+        players[i].Restore(snapshot.players[i]);
+    }
+
+    state = snapshot.state;
+}
+
+void GameEngine::Start(uint64_t seed) {
+    state.rng.Seed(seed);
+
+    for (int i = 0; i < NUM_PLAYERS; i++) { // Each player gets their own generator derived from the game's
+        players[i].SetSeed(state.rng.Next());
+    }
+
+    state.startingPlayer = state.rng.NextInt(NUM_PLAYERS); // 0 = First player starts, 1 = Second player starts
+    state.currentPlayer = state.startingPlayer;
+    state.winner = -1;
+    state.turnCount = 0;
+    state.over = false;
+    state.numShots = 0;
+}
+
+Player& GameEngine::GetPlayer(int index) {
+    return players[index];
+}
+
+const Player& GameEngine::GetPlayer(int index) const {
+    return players[index];
+}
+
+uint64_t GameEngine::GetSeed() const {
+    return state.rng.GetSeed();
+}
+
+int GameEngine::GetStartingPlayer() const {
+    return state.startingPlayer;
+}
+
+int GameEngine::GetCurrentPlayer() const {
+    return state.currentPlayer;
+}
+
+void GameEngine::GenerateComputerShips() {
+    for (int i = 0; i < NUM_PLAYERS; i++) {
+        int order = (state.startingPlayer + i) % NUM_PLAYERS; // Ships are placed in turn order
+
+        if (players[order].IsComputer() && !players[order].IsSetUp()) {
+            for (int shipId = 0; shipId < Player::MAX_SHIPS; shipId++) {
+                players[order].PlaceRandomShip(shipId);
+            }
+        }
+    }
+}
+
+bool GameEngine::IsSetUp() const {
+    return players[0].IsSetUp() && players[1].IsSetUp();
+}
+
+Coord GameEngine::GetComputerShot() {
+    return players[state.currentPlayer].PromptComputerCoord();
+}
+
+GameEngine::Result GameEngine::Step(Coord shot) {
+    Result result;
+    result.shooter = state.currentPlayer;
+
+    if (state.over || !IsSetUp()) {
+        return result;
+    }
+
+    Player& player = players[state.currentPlayer];
+    Player& opponent = players[(state.currentPlayer + 1) % NUM_PLAYERS];
+
+    if (!player.CallCoord(shot, opponent)) {
+        return result;
+    }
+
+    result.accepted = true;
+    state.shotLog[state.numShots] = shot.GetIndex();
+    state.numShots++;
+
+    if (player.IsTurnOver(opponent)) {
+        result.numShots = player.ResolveCalls(opponent, result.shots);
+        result.turnOver = true;
+        state.turnCount++;
+
+        if (player.GetShipsDestroyed() == Player::MAX_SHIPS) {
+            state.over = true;
+            state.winner = state.currentPlayer;
+        } else {
+            state.currentPlayer = (state.currentPlayer + 1) % NUM_PLAYERS;
+        }
+    }
+
+    result.gameOver = state.over;
+    return result;
+}
+
+bool GameEngine::IsOver() const {
+    return state.over;
+}
+
+int GameEngine::GetWinner() const {
+    return state.winner;
+}
+
+int GameEngine::GetTurnCount() const {
+    return state.turnCount;
+}
+
+int GameEngine::GetNumShots() const {
+    return state.numShots;
+}
+
+Coord GameEngine::GetShot(int index) const {
+    return Coord::FromIndex(state.shotLog[index]);
+}
@@ -0,0 +1,172 @@
+#ifndef GAMEENGINE_H
+#define GAMEENGINE_H
+#include "Player.h"
+#include "Random.h"
+#include <cstdint>
+#include <type_traits>
+using namespace std;
+
+/**
+ * Runs a game between two players without any terminal I/O.
+ * Front-ends place ships through GetPlayer and then feed one called coordinate at a time to Step.
+ */
+class GameEngine {
+public:
+    static const int NUM_PLAYERS = 2;
+    static const int MAX_SHOTS = NUM_PLAYERS * Player::MAX_SIZE * Player::MAX_SIZE; // Each player can call every cell once
+
+    /**
+     * Outcome of feeding one coordinate to the engine.
+     */
+    struct Result {
+        bool accepted = false; // False if the coordinate was off the board or already called
+        bool turnOver = false; // Whether the shooter's calls were resolved and play passed on
+        bool gameOver = false;
+        int shooter = 0; // Index of the player who called the coordinate
+        Player::ShotResult shots[Player::MAX_SHIPS]; // Resolved calls, only filled in when turnOver is true
+        int numShots = 0; // Number of resolved calls in shots
+    };
+
+    /**
+     * Everything the engine itself changes as a game is played, as plain data so it can be copied in one assignment.
+     */
+    struct State {
+        Random rng;
+        int startingPlayer;
+        int currentPlayer;
+        int winner;
+        int turnCount;
+        bool over;
+        unsigned char shotLog[MAX_SHOTS]; // Bit index of every accepted call, in order
+        int numShots;
+    };
+
+    /**
+     * A whole game at one point: the engine's state and both players' states.
+     */
+    struct SavedGame {
+        Player::State players[NUM_PLAYERS];
+        State state;
+    };
+
+    /**
+     * Starts a game and randomly decides which player goes first.
+     * Every random choice in the game, including the computers', comes from the seed, so a game can be replayed from it.
+     * @param first The first player (the user in the console game).
+     * @param second The second player.
+     * @param seed Seed of the game.
+     */
+    GameEngine(const Player& first, const Player& second, uint64_t seed);
+
+    /**
+     * Starts a new game between the same players, clearing their fleets and shots, as if the engine had just been made.
+     * @param seed Seed of the new game.
+     */
+    void Reset(uint64_t seed);
+
+    /**
+     * Takes a snapshot of the game so it can be restored later, for example to try out a line of play.
+     * @return The whole game.
+     */
+    SavedGame Snapshot() const;
+
+    /**
+     * Puts the game back into a state taken by Snapshot.
+     * @param snapshot Game to restore.
+     */
+    void Restore(const SavedGame& snapshot);
+
+    /**
+     * Gets a player of the game.
+     * @param index 0 for the first player, 1 for the second.
+     * @return The player.
+     */
+    Player& GetPlayer(int index);
+    const Player& GetPlayer(int index) const;
+
+    /**
+     * Gets the seed the game was started with.
+     * @return Seed.
+     */
+    uint64_t GetSeed() const;
+
+    /**
+     * Gets the player who was chosen to go first.
+     * @return Index of the starting player.
+     */
+    int GetStartingPlayer() const;
+
+    /**
+     * Gets the player whose turn it is.
+     * @return Index of the current player.
+     */
+    int GetCurrentPlayer() const;
+
+    /**
+     * Places any ships the computer players still need, without displaying anything.
+     */
+    void GenerateComputerShips();
+
+    /**
+     * Checks if both players have placed all their ships.
+     * @return Whether or not the game can be played.
+     */
+    bool IsSetUp() const;
+
+    /**
+     * Asks the current player (a computer) for its next coordinate.
+     * @return Coordinate to call.
+     */
+    Coord GetComputerShot();
+
+    /**
+     * Calls a coordinate for the current player. Once their turn's calls are used up, every call is shot and play passes on.
+     * @param shot Coordinate to call.
+     * @return What happened to the call.
+     */
+    Result Step(Coord shot);
+
+    /**
+     * Checks if a player has sunk all of their opponent's ships.
+     * @return Whether or not the game is over.
+     */
+    bool IsOver() const;
+
+    /**
+     * Gets the winner of a finished game.
+     * @return Index of the winning player.
+     */
+    int GetWinner() const;
+
+    /**
+     * Gets the number of turns that have been completed by both players.
+     * @return Number of turns.
+     */
+    int GetTurnCount() const;
+
+    /**
+     * Gets the number of coordinates accepted by Step so far, by both players.
+     * @return Number of calls.
+     */
+    int GetNumShots() const;
+
+    /**
+     * Gets a coordinate accepted by Step. Feeding every one of them to Step again, in order, replays the game.
+     * @param index Index of the call, from 0 for the first call of the game.
+     * @return Coordinate that was called.
+     */
+    Coord GetShot(int index) const;
+private:
+    Player players[NUM_PLAYERS];
+    State state;
+
+    /**
+     * Seeds the game and its players and decides which player goes first.
+     * @param seed Seed of the game.
+     */
+    void Start(uint64_t seed);
+};
+
+static_assert(is_trivially_copyable<GameEngine::SavedGame>::value, "A snapshot must copy as plain memory");
+
+#endif
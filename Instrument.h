@@ -0,0 +1,149 @@
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+// Without BATTLESHIP_INSTRUMENT, this header only defines the BATTLESHIP_COUNT, BATTLESHIP_TIME and BATTLESHIP_END_TURN
+// macros, which expand to nothing, so the paths cost exactly what they would without them.
+#ifndef BATTLESHIP_INSTRUMENT
+#define BATTLESHIP_COUNT(counters, counter) static_cast<void>(0)
+#define BATTLESHIP_TIME(counters, timer) static_cast<void>(0)
+#define BATTLESHIP_END_TURN(counters) static_cast<void>(0)
+#else
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <string>
+using namespace std;
+
+/**
+ * Counters and timers of a player's hot paths, summed over one game.
+ */
+class Instrument {
+public:
+    enum Counter {
+        SHOTS,
+        CALL_RETRIES, // Calls or hard-search picks rejected for being off the board or called before
+        PLACEMENT_RETRIES, // Ship placements rejected while setting up
+        SEARCHES_CREATED,
+        DIRECTIONS_FINISHED,
+        NUM_COUNTERS
+    };
+
+    enum Timer {
+        PROMPT_TIMER, // Player::PromptComputerCoord
+        SHOOT_TIMER, // Player::ShootCoord
+        NUM_TIMERS
+    };
+
+    /**
+     * Everything counted for one player.
+     */
+    struct Counters {
+        long long counts[NUM_COUNTERS] = {};
+        long long timerCalls[NUM_TIMERS] = {};
+        long long timerNs[NUM_TIMERS] = {};
+        long long timerMaxNs[NUM_TIMERS] = {};
+        long long turnStartPrompts = 0; // Prompts made before the current turn
+        long long maxTurnPrompts = 0; // Most prompts made in one turn
+    };
+
+    /**
+     * Adds the time from its construction to its destruction to one of a player's timers.
+     */
+    class ScopedTimer {
+    public:
+        /**
+         * Starts timing.
+         * @param counters The player's counters.
+         * @param timer Timer to add to.
+         */
+        ScopedTimer(Counters& counters, Timer timer);
+
+        /**
+         * Stops timing and adds the time.
+         */
+        ~ScopedTimer();
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    private:
+        Counters& counters;
+        Timer timer;
+        chrono::steady_clock::time_point start;
+    };
+
+    /**
+     * Marks the end of a player's turn, keeping track of the most prompts a turn took.
+     * @param counters The player's counters.
+     */
+    static void EndTurn(Counters& counters);
+
+    /**
+     * Describes a player's counters for the end of a game.
+     * @param name Name of the player.
+     * @param counters The player's counters.
+     * @return One line per counter and timer.
+     */
+    static string Summarize(const string& name, const Counters& counters);
+};
+
+#define BATTLESHIP_CONCAT_INNER(a, b) a##b
+#define BATTLESHIP_CONCAT(a, b) BATTLESHIP_CONCAT_INNER(a, b)
+#define BATTLESHIP_COUNT(counters, counter) (++(counters).counts[Instrument::counter])
+#define BATTLESHIP_TIME(counters, timer) \
+    Instrument::ScopedTimer BATTLESHIP_CONCAT(instrumentTimer, __LINE__)((counters), Instrument::timer)
+#define BATTLESHIP_END_TURN(counters) Instrument::EndTurn(counters)
+
+inline Instrument::ScopedTimer::ScopedTimer(Counters& counters, Timer timer)
+    : counters(counters), timer(timer), start(chrono::steady_clock::now()) {}
+
+inline Instrument::ScopedTimer::~ScopedTimer() {
+    long long ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    counters.timerCalls[timer]++;
+    counters.timerNs[timer] += ns;
+
+    if (ns > counters.timerMaxNs[timer]) {
+        counters.timerMaxNs[timer] = ns;
+    }
+}
+
+inline void Instrument::EndTurn(Counters& counters) {
+    long long prompts = counters.timerCalls[PROMPT_TIMER] - counters.turnStartPrompts;
+
+    if (prompts > counters.maxTurnPrompts) {
+        counters.maxTurnPrompts = prompts;
+    }
+
+    counters.turnStartPrompts = counters.timerCalls[PROMPT_TIMER];
+}
+
+inline string Instrument::Summarize(const string& name, const Counters& counters) {
+    const string COUNTER_NAMES[NUM_COUNTERS] = {"Shots", "Call retries", "Placement retries", "Searches created",
+                                                "Directions finished"};
+    const string TIMER_NAMES[NUM_TIMERS] = {"PromptComputerCoord", "ShootCoord"};
+    const int LABEL_SPACING = 25;
+    const int INDENT = 2;
+
+    ostringstream summary;
+    summary << left << "Instrumentation for " << name << ":\n";
+
+    for (int i = 0; i < NUM_COUNTERS; i++) {
+        summary << setw(INDENT) << "" << setw(LABEL_SPACING - INDENT) << COUNTER_NAMES[i] << counters.counts[i] << "\n";
+    }
+
+    for (int i = 0; i < NUM_TIMERS; i++) {
+        long long calls = counters.timerCalls[i];
+        summary << setw(INDENT) << "" << setw(LABEL_SPACING - INDENT) << TIMER_NAMES[i] << calls << " calls";
+
+        if (i == PROMPT_TIMER) {
+            summary << ", most in a turn " << counters.maxTurnPrompts;
+        }
+
+        summary << ", mean " << ((calls > 0) ? counters.timerNs[i] / calls : 0) << " ns, max " << counters.timerMaxNs[i]
+                << " ns\n";
+    }
+
+    return summary.str();
+}
+#endif
+
+#endif
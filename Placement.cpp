@@ -0,0 +1,71 @@
+#include "Placement.h"
+#include "Bitboard.h"
+using namespace std;
+
+void Placement::GetLegalAnchors(int length, const Bitboard& blocked, Bitboard& horizontal, Bitboard& vertical) {
+    Bitboard open = ~blocked;
+    Bitboard east = open;
+    Bitboard south = open;
+    horizontal = open;
+    vertical = open;
+
+    for (int i = 1; i < length; i++) { // Bring the cell i spaces along onto the anchor
+        east = east.ShiftWest();
+        south = south.ShiftNorth();
+        horizontal &= east;
+        vertical &= south;
+    }
+}
+
+void Placement::GetLegalMasks(int length, const Bitboard& blocked, Bitboard masks[NUM_DIRECTIONS]) {
+#ifdef BATTLESHIP_SCALAR_PLACEMENT
+    GetLegalMasksScalar(length, blocked, masks);
+#else
+    Bitboard horizontal;
+    Bitboard vertical;
+    GetLegalAnchors(length, blocked, horizontal, vertical);
+
+    // A ship running north or west covers the same cells as one running south or east from its other end.
+    Bitboard north = vertical;
+    Bitboard west = horizontal;
+
+    for (int i = 1; i < length; i++) {
+        north = north.ShiftSouth();
+        west = west.ShiftEast();
+    }
+
+    masks[Ship::NORTH] = north;
+    masks[Ship::EAST] = horizontal;
+    masks[Ship::SOUTH] = vertical;
+    masks[Ship::WEST] = west;
+#endif
+}
+
+void Placement::GetLegalMasksScalar(int length, const Bitboard& blocked, Bitboard masks[NUM_DIRECTIONS]) {
+    const int SIZE = Bitboard::SIZE;
+
+    for (int dir = 0; dir < NUM_DIRECTIONS; dir++) {
+        masks[dir] = Bitboard();
+
+        for (int row = 0; row < SIZE; row++) {
+            for (int col = 0; col < SIZE; col++) {
+                bool legal = true;
+
+                for (int i = 0; i < length && legal; i++) {
+                    int shipRow = row + i * Ship::ROW_DELTAS[dir];
+                    int shipCol = col + i * Ship::COL_DELTAS[dir];
+
+                    if (shipRow < 0 || shipRow >= SIZE || shipCol < 0 || shipCol >= SIZE) {
+                        legal = false;
+                    } else if (blocked.Test(Bitboard::Index(shipRow, shipCol))) {
+                        legal = false;
+                    }
+                }
+
+                if (legal) {
+                    masks[dir].Set(Bitboard::Index(row, col));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef PLACEMENT_H
+#define PLACEMENT_H
+#include "Bitboard.h"
+#include "Ship.h"
+using namespace std;
+
+/**
+ * Counts the ways ships can lie on a board, working on whole bitboards at a time.
+ */
+class Placement {
+public:
+    static const int MAX_LENGTH = Ship::CARRIER_HP;
+    static const int NUM_DIRECTIONS = Ship::NUM_DIRECTIONS; // Masks are indexed by Ship::Direction
+
+    /**
+     * Finds every cell a ship can start from, for both axes. A horizontal ship starts at its leftmost cell and a
+     * vertical ship at its topmost cell.
+     * @param length Length of the ship.
+     * @param blocked Cells the ship cannot be on.
+     * @param horizontal Receives the legal starting cells of horizontal ships.
+     * @param vertical Receives the legal starting cells of vertical ships.
+     */
+    static void GetLegalAnchors(int length, const Bitboard& blocked, Bitboard& horizontal, Bitboard& vertical);
+
+    /**
+     * Finds every legal placement of a ship at once, one mask per Ship::Direction. A cell is set in masks[d] if a ship
+     * starting there and running toward direction d stays on the board and avoids every blocked cell, which is the
+     * rule Player::IsValidCoord checks one placement at a time.
+     * Builds defining BATTLESHIP_SCALAR_PLACEMENT use GetLegalMasksScalar instead of shifting whole bitboards.
+     * @param length Length of the ship.
+     * @param blocked Cells the ship cannot be on.
+     * @param masks Receives the legal starting cells of each direction.
+     */
+    static void GetLegalMasks(int length, const Bitboard& blocked, Bitboard masks[NUM_DIRECTIONS]);
+
+    /**
+     * Finds the same masks as GetLegalMasks by walking every placement one cell at a time.
+     * @param length Length of the ship.
+     * @param blocked Cells the ship cannot be on.
+     * @param masks Receives the legal starting cells of each direction.
+     */
+    static void GetLegalMasksScalar(int length, const Bitboard& blocked, Bitboard masks[NUM_DIRECTIONS]);
+};
+
+#endif
@@ -1,51 +1,71 @@
 #include "Player.h"
+#include "Placement.h"
 #include "Ship.h"
-#include <iostream>
-#include <iomanip>
-#include <vector>
+#include "Instrument.h"
 #include <string>
-#include <cctype>
+#include <cstdint>
 #include <cstdlib>
 #include <cmath>
+#include <algorithm>
 using namespace std;
 
+const char* const Player::SHIP_NAMES[MAX_SHIPS] = {"Destroyer", "Submarine", "Cruiser", "Battleship", "Carrier"};
+const int Player::SHIP_LENGTHS[MAX_SHIPS] = {Ship::DESTROYER_HP, Ship::SUBMARINE_HP, Ship::CRUISER_HP, Ship::BATTLESHIP_HP, Ship::CARRIER_HP};
+
 Player::Player() {
     name = "";
-    numCalls = 1;
+    isComputer = false;
     isClassic = false;
-    isHardmode = false;
+    difficulty = EASY;
 
     MakeLetters();
-    GenerateEmptyBoard(offensiveBoard);
-    GenerateEmptyBoard(shipBoard);
-    settingUpShips = true;
-    callCount = 0;
-    hitCount = 0;
-    shipsDestroyed = 0;
-    shipsLost = 0;
+    Reset();
 }
 
 Player::Player(string playerName, bool isComputer, bool isClassic, bool isHardmode) {
     name = playerName;
     this->isComputer = isComputer;
-    isClassic ? numCalls = 1 : numCalls = MAX_SHIPS;
     this->isClassic = isClassic;
-    this->isHardmode = isHardmode;
+    difficulty = isHardmode ? HARD : EASY;
 
     MakeLetters();
-    GenerateEmptyBoard(offensiveBoard);
-    GenerateEmptyBoard(shipBoard);
-    settingUpShips = true;
-    callCount = 0;
-    hitCount = 0;
-    shipsDestroyed = 0;
-    shipsLost = 0;
-}
-
-void Player::DeleteShips() {
-    for (int i = 0; i < MAX_SHIPS; i++) {
-        delete ships[i];
-        ships[i] = nullptr;
+    Reset();
+}
+
+Player::State Player::Snapshot() const {
+    return state;
+}
+
+void Player::Restore(const State& snapshot) {
+    state = snapshot;
+}
+
+void Player::Reset() {
+    isClassic ? state.numCalls = 1 : state.numCalls = MAX_SHIPS;
+    state.offensiveBoard = Board();
+    state.shipBoard = Board();
+    state.settingUpShips = true;
+    state.callCount = 0;
+    state.hitCount = 0;
+    state.numPrevTurnHits = 0;
+    state.numPendingCalls = 0;
+    state.pendingHits = 0;
+    state.numShips = 0;
+    ClearShipIndex();
+    state.shipsDestroyed = 0;
+    state.shipsLost = 0;
+    state.opponentShipsSunk = 0;
+    state.density.Reset(SHIP_LENGTHS, MAX_SHIPS);
+    state.numSearches = 0;
+    state.numShipsHit = 0;
+#ifdef BATTLESHIP_INSTRUMENT
+    instrument = Instrument::Counters();
+#endif
+}
+
+void Player::ClearShipIndex() {
+    for (int i = 0; i < MAX_SIZE * MAX_SIZE; i++) {
+        state.shipIndex[i] = NO_SHIP;
     }
 }
 
@@ -53,6 +73,34 @@ string Player::GetName() const {
     return name;
 }
 
+bool Player::IsComputer() const {
+    return isComputer;
+}
+
+bool Player::IsClassic() const {
+    return isClassic;
+}
+
+void Player::SetDifficulty(Difficulty newDifficulty) {
+    difficulty = newDifficulty;
+}
+
+Player::Difficulty Player::GetDifficulty() const {
+    return difficulty;
+}
+
+void Player::SetSamplerBudget(const FleetSampler::Budget& budget) {
+    samplerBudget = budget;
+}
+
+void Player::SetSeed(uint64_t seed) {
+    state.rng.Seed(seed);
+}
+
+uint64_t Player::GetSeed() const {
+    return state.rng.GetSeed();
+}
+
 void Player::MakeLetters() {
     int rowCount = 0;
     for (char row = STARTING_LETTER; row < (STARTING_LETTER + MAX_SIZE); row++) {
@@ -61,364 +109,162 @@ void Player::MakeLetters() {
     }
 }
 
-void Player::GenerateEmptyBoard(vector<vector<int>>& board) {
-    for (int i = 0; i < MAX_SIZE; i++) {
-        vector<int> emptyRow;
-
-        for (int j = 0; j < MAX_SIZE; j++) {
-            emptyRow.push_back(NOTHING_INT);
-        }
+void Player::SetShipBoard(int row, int col, int value) {
+    state.shipBoard.Set(row, col, value);
+}
 
-        board.push_back(emptyRow);
-    }
+const Board& Player::GetShipBoard() const {
+    return state.shipBoard;
 }
 
-void Player::SetShipBoard(int row, int col, int value) {
-    shipBoard[row][col] = value;
-}
-
-vector<vector<int>> Player::GetShipBoard() const {
-    return shipBoard;
-}
-
-void Player::DisplayBoard(const vector<vector<int>>& board, string info, bool showLost) const {
-    const char NOTHING_MARKER = '*';
-    const char MISS_MARKER = '-';
-    const char HIT_MARKER = 'x';
-    const char SHIP_MARKER = 'O';
-    const char SUNKEN_MARKER = '~';
-    const char TOP = '-';
-    const char SIDE = '|';
-
-    const int NUMBER_OFFSET_L = 4;
-    const int NUMBER_OFFSET_R = 2;
-    const int NUMBER_SPACING = 2;
-    const int LETTER_OFFSET = 1;
-    const int GRID_SPACING = 2;
-    const int BOARD_PADDING = 15;
-
-    cout << "\n\n";
-
-    // Creates the name, ship destroyed indicator, top bar, numbering 1-10,.
-    string numbers = "";
-    string topBottomBar = "";
-    string numberOffsetL(NUMBER_OFFSET_L, ' ');
-    string numberOffsetR(NUMBER_OFFSET_R, ' ');
-    string numberSpacing(NUMBER_SPACING, ' ');
-    numbers += numberOffsetL;
-
-    for (int i = 1; i <= MAX_SIZE; i++) {
-        numbers += to_string(i);
-        (i != 10) ? numbers += numberSpacing : numbers += numberOffsetR; // Add offset to end as well
+bool Player::PlaceShip(int shipId, Coord coord, Ship::Direction orientation) {
+    if (shipId != state.numShips || !IsValidCoord(state.shipBoard, coord, SHIP_LENGTHS[shipId], orientation)) {
+        return false;
     }
 
-    for (int i = 0; i < numbers.length() + 2; i++) { // Accounts for the sides (additional spacing)
-        topBottomBar += TOP;
+    state.ships[state.numShips] = CreateShip(SHIP_NAMES[shipId], SHIP_LENGTHS[shipId], coord, orientation);
+    state.numShips++;
+
+    if (state.numShips == MAX_SHIPS) {
+        state.settingUpShips = false;
     }
 
-    string description = name + "'s " + info;
-    string shipsInfotring = "";
+    return true;
+}
 
-    if (!showLost) { // Display # of ships the player has taken instead of ships lost
-        shipsInfotring = "Ships Taken: " + to_string(shipsDestroyed);
-    } else {
-        shipsInfotring = "Ships Lost: " + to_string(shipsLost);
-    }
-    
-    const int SHIPS_DESTROYED_SPACING = topBottomBar.length() - shipsInfotring.length();
-
-    cout << left << setw(BOARD_PADDING) << "" << setw(SHIPS_DESTROYED_SPACING) << description << shipsInfotring << "\n";
-    cout << setw(BOARD_PADDING) << "" << topBottomBar << "\n";
-    cout << setw(BOARD_PADDING) << "" << SIDE << numbers << SIDE << "\n";
-
-    // Creates letters A-J and grid.
-    string letterOffset(LETTER_OFFSET, ' ');
-    string gridSpacing(GRID_SPACING, ' ');
-
-    for (int row = 0; row < MAX_SIZE; row++) {
-        string gridRow = "";
-        cout << setw(BOARD_PADDING) << "" << SIDE << letterOffset << letters[row];
-        
-        for (int col = 0; col < MAX_SIZE; col++) {
-            int coordinate = board[row][col];
-            
-            gridRow += gridSpacing;
-            if (coordinate == MISS_INT) {
-                gridRow += MISS_MARKER;
-            } else if (coordinate == HIT_INT) {
-                gridRow += HIT_MARKER;
-            } else if (coordinate == SHIP_INT) {
-                gridRow += SHIP_MARKER;
-            } else if (coordinate == SUNKEN_INT) {
-                gridRow += SUNKEN_MARKER;
-            } else {
-                gridRow += NOTHING_MARKER;
-            }
-        }
-        
-        while (gridRow.length() + 1 < numbers.length() - 1) { // Align right side of grid by adding needed spaces
-            gridRow += " ";
-        }
+void Player::PlaceRandomShip(int shipId) {
+    Bitboard masks[Placement::NUM_DIRECTIONS];
+    Placement::GetLegalMasks(SHIP_LENGTHS[shipId], state.shipBoard.GetPlane(SHIP_INT), masks);
+
+    // Pick one legal placement uniformly, counting through the masks instead of guessing and retrying.
+    // A 10x10 board always has room for the next ship, so there is at least one.
+    int total = 0;
 
-        cout << gridRow;
-        cout << SIDE << "\n";
+    for (int dir = 0; dir < Placement::NUM_DIRECTIONS; dir++) {
+        total += masks[dir].Count();
     }
 
-    cout << setw(BOARD_PADDING) << "" << topBottomBar << "\n\n";
-    cout << right;
-}
+    int pick = state.rng.NextInt(total);
+    int dir = 0;
 
-void Player::GenerateShips() {
-    // Instantiate the five types of ships in the game.
-    vector<Ship> tempShips;
+    while (pick >= masks[dir].Count()) {
+        pick -= masks[dir].Count();
+        dir++;
+    }
 
-    Ship destroyer("Destroyer", Ship::DESTROYER_HP);
-    tempShips.push_back(destroyer);
-    Ship submarine("Submarine", Ship::SUBMARINE_HP);
-    tempShips.push_back(submarine);
-    Ship cruiser("Cruiser", Ship::CRUISER_HP);
-    tempShips.push_back(cruiser);
-    Ship battleship("Battleship", Ship::BATTLESHIP_HP);
-    tempShips.push_back(battleship);
-    Ship carrier("Carrier", Ship::CARRIER_HP);
-    tempShips.push_back(carrier);
-    
-    // Let user/computer come up with coordinates and orientations to use.
-    for (int i = 0; i < MAX_SHIPS; i++) {
-        Ship tempShip = tempShips[i];
-        string shipName = tempShip.GetName();
-        int shipLength = tempShip.GetLength();
-        vector<int> coord;
-        string orientation;
-
-        bool valid = false;
-        if (!isComputer) {
-            do {
-                cout << "\n< " << shipName << " (" << shipLength << " spaces) >";
-                coord = PromptUserCoord();
-                orientation = PromptUserOrientation();
-                
-                if (IsValidCoord(shipBoard, coord, shipLength, orientation)) {
-                    valid = true;
-                } else {
-                    cout << "Sorry, invalid ship.\n";
-                }
-            } while (!valid);
-            cout << "\nShip set!\n";
-        } else {
-            do {
-                coord = PromptComputerCoord();
-                orientation = Ship::ORIENTATIONS[rand() % Ship::ORIENTATIONS.size()];
+    int index = masks[dir].Select(pick);
+    PlaceShip(shipId, Coord::FromIndex(index), static_cast<Ship::Direction>(dir));
+}
 
-                if (IsValidCoord(shipBoard, coord, shipLength, orientation)) {
-                    valid = true;
-                }
-            } while (!valid);
-        }
+bool Player::IsSetUp() const {
+    return !state.settingUpShips;
+}
 
-        ships.push_back(CreateShip(shipName, shipLength, coord, orientation));
-        DisplayBoard(shipBoard, "Ships", true);
-    }
+const Ship* Player::GetShips() const {
+    return state.ships;
+}
 
-    settingUpShips = false;
+int Player::GetNumShips() const {
+    return state.numShips;
 }
 
-vector<Ship*> Player::GetShips() {
-    return ships;
+Ship* Player::GetShip(int shipId) {
+    return &state.ships[shipId];
 }
 
-Ship* Player::CreateShip(string name, int length, const vector<int>& coord, string orientation) {
-    Ship* tempShip = new Ship(name, length);
-    tempShip->SetOrientation(orientation);
-    tempShip->SetCoord(coord);
+int Player::GetShipAt(int row, int col) const {
+    return state.shipIndex[Bitboard::Index(row, col)];
+}
 
-    int row = coord[ROW_INDEX];
-    int col = coord[COL_INDEX];
+Ship Player::CreateShip(const char* name, int length, Coord coord, Ship::Direction orientation) {
+    Ship tempShip(name, length);
+    tempShip.SetOrientation(orientation);
+    int shipId = state.numShips; // The ship is added to ships right after it is created
 
-    shipBoard[row][col] = SHIP_INT;
-    for (int i = 1; i < length; i++) {
-        if (orientation == Ship::NORTH) {
-            row--;
-        } else if (orientation == Ship::EAST) {
-            col++;
-        } else if (orientation == Ship::SOUTH) {
-            row++;
-        } else {
-            col--;
-        }
-        
-        vector<int> newCoord;
-        newCoord.push_back(row);
-        newCoord.push_back(col);
-        tempShip->SetCoord(newCoord);
-        shipBoard[row][col] = SHIP_INT;
+    for (int i = 0; i < length; i++) {
+        tempShip.SetCoord(coord);
+        state.shipBoard.Set(coord.row, coord.col, SHIP_INT);
+        state.shipIndex[coord.GetIndex()] = shipId;
+        coord = GetNext(coord, orientation);
     }
-    
+
     return tempShip;
 }
 
 int Player::GetShipSpacesLeft(Player& opponent) {
-    int difference = 0;
-    vector<Ship*> allShips = opponent.GetShips();
-    vector<vector<int>> allShipCoords;
-    vector<vector<int>> allShipHitCoords;
-
-    for (int i = 0; i < MAX_SHIPS; i++) { // Gets all coordinates of ships
-        Ship currShip = *allShips[i];
-
-        for (vector<int> shipCoord : currShip.GetCoords()) {
-            allShipCoords.push_back(shipCoord);
-        }
-
-        for (vector<int> shipHitCoord : currShip.GetHitCoords()) {
-            allShipHitCoords.push_back(shipHitCoord);
-        }
-    }
+    // A ship space leaves the SHIP_INT plane as soon as it is hit, so the plane holds exactly the spaces left.
+    return opponent.GetShipBoard().GetPlane(SHIP_INT).Count();
+}
 
-    difference = allShipCoords.size() - allShipHitCoords.size();
-    return difference;
+const Coord* Player::GetHitsPrev() const {
+    return state.prevTurnHits;
 }
 
-vector<vector<int>> Player::GetHitsPrev() const {
-    return prevTurnHits;
+int Player::GetNumHitsPrev() const {
+    return state.numPrevTurnHits;
 }
 
 void Player::ResetHitsPrev() {
-    prevTurnHits.clear();
+    state.numPrevTurnHits = 0;
 }
 
 int Player::GetShipsLost() const {
-    return shipsLost;
+    return state.shipsLost;
 }
 
 void Player::IncShipsLost() {
-    shipsLost++;
-}
-
-void Player::Turn(Player& opponent) {
-    if (opponent.GetShipsDestroyed() < MAX_SHIPS) { // Check if there are still shots to take
-        // Output status and prompt for user's coordinate.
-        DisplayBoard(shipBoard, "Ships", true);
-        DisplayBoard(offensiveBoard, "Shots", false);
-        cout << "\nIt is Captain " << name << "'s turn. You have " << numCalls << " call" << ((numCalls > 1) ? "s." : ".") << "\n";
-        
-        vector<vector<int>> opponentHits = opponent.GetHitsPrev();
-        int prevTimesHit = opponentHits.size();
-        if (prevTimesHit > 0) {
-            cout << "WARNING: " << opponent.GetName() << " has hit your fleet at";
-            
-            // Convert row ints to chars.
-            vector<char> rowChars;
-            for (vector<int> coord : opponentHits) {
-                char rowChar;
-                for (int i = 0; i < MAX_SIZE; i++) {
-                    if (coord[ROW_INDEX] == i) {
-                        rowChar = letters[i];
-                        rowChars.push_back(rowChar);
-                        break;
-                    }
-                }
-            }
-
-            for (int i = 0; i < prevTimesHit; i++) {
-                vector<int> coord = opponentHits[i];
-                cout << " " << rowChars[i] << to_string(coord[COL_INDEX] + 1);
-                
-                if (prevTimesHit > 1 && i == prevTimesHit - 2) {
-                    cout << " and";
-                }
-
-                if (i < prevTimesHit - 2) {
-                    cout << ",";
-                }
-            }
-            cout << ".\n";
-            opponent.ResetHitsPrev();
-        } else {
-            cout << "NOTE: " << opponent.GetName() << " has not hit your fleet.\n";
-        }
-
-        vector<vector<int>> playerCoords;
-        vector<int> playerCoord;
-        int boardValue;
-
-        // Prompts player numCalls times, checking if their coordinates haven't already been called on the player's board.
-        int currHitCounter = 0;
-        
-        for (int i = 0; i < numCalls; i++) {
-            if (currHitCounter == GetShipSpacesLeft(opponent)) { // Player has already hit all their opponent's ships, so break loop
-                break;
-            }
-
-            bool isPreviousCoord = true;
-
-            do {
-                isPreviousCoord = true;
+    state.shipsLost++;
+}
 
-                playerCoord = (isComputer) ? PromptComputerCoord() : PromptUserCoord();
-                boardValue = offensiveBoard[playerCoord[ROW_INDEX]][playerCoord[COL_INDEX]];
+bool Player::CallCoord(Coord coord, Player& opponent) {
+    if (!IsValidCoord(state.offensiveBoard, coord) || state.numPendingCalls == MAX_SHIPS) { // Off the board, shot at before, or already called this turn
+        BATTLESHIP_COUNT(instrument, CALL_RETRIES);
+        return false;
+    }
 
-                if (boardValue != MISS_INT && boardValue != HIT_INT && boardValue != SUNKEN_INT) { // See if coordinate was input before turn
-                    isPreviousCoord = false;
+    if (opponent.GetShipAt(coord.row, coord.col) != NO_SHIP) {
+        state.pendingHits++;
+    }
 
-                    for (int j = 0; j < playerCoords.size(); j++) { // See if the coordinate was already input in the turn
-                        if (playerCoords[j] == playerCoord) {
-                            isPreviousCoord = true;
-                            break;
-                        }
-                    }
-                }
-                
-                if (!isComputer && isPreviousCoord) {
-                    cout << "You cannot call a previous coordinate, Captain.\n";
-                }
-            } while (isPreviousCoord);
-            if (opponent.GetShipBoard()[playerCoord[ROW_INDEX]][playerCoord[COL_INDEX]] == SHIP_INT) {
-                currHitCounter++;
-            }
-            offensiveBoard[playerCoord[ROW_INDEX]][playerCoord[COL_INDEX]] = TEMP_INT;
-            playerCoords.push_back(playerCoord);
-        }
+    state.offensiveBoard.Set(coord.row, coord.col, TEMP_INT);
+    state.pendingCalls[state.numPendingCalls] = coord;
+    state.numPendingCalls++;
+    return true;
+}
 
-        // Reset temporary states related to hardmode searching.
-        for (int i = 0; i < MAX_SIZE; i++) {
-            for (int j = 0; j < MAX_SIZE; j++) {
-                if (offensiveBoard[i][j] == TEMP_INT) {
-                    offensiveBoard[i][j] = NOTHING_INT;
-                }
-            }
-        }
+bool Player::IsTurnOver(Player& opponent) {
+    // The turn also ends early once the player has called every space their opponent has left.
+    return state.numPendingCalls >= state.numCalls || state.pendingHits == GetShipSpacesLeft(opponent);
+}
 
-        for (SearchData sd : searches) {
-            sd.priority = sd.spacesLeft;
-        }
+int Player::ResolveCalls(Player& opponent, ShotResult results[]) {
+    // Reset temporary states related to hardmode searching.
+    state.offensiveBoard.ClearPlane(TEMP_INT);
 
-        // Checks the result of the coordinate call after the player has called all coordinates in their turns.
-        string result = "\n";
-        for (vector<int> coord : playerCoords) {
-            result += ShootCoord(coord, opponent);
-        }
-        
-        DisplayBoard(offensiveBoard, "Shots", false);
-        cout << result;
+    // Checks the result of the coordinate call after the player has called all coordinates in their turns.
+    int numResults = state.numPendingCalls;
+    for (int i = 0; i < numResults; i++) {
+        results[i] = ShootCoord(state.pendingCalls[i], opponent);
     }
+
+    state.numPendingCalls = 0;
+    state.pendingHits = 0;
+    BATTLESHIP_END_TURN(instrument);
+    return numResults;
 }
 
-string Player::LowerTurn() {
-    if (numCalls > 0 && !isClassic) {
-        numCalls--;
-        return "\nThe number of coordinates " + name + " can call has been decreased.";
+bool Player::LowerTurn() {
+    if (state.numCalls > 0 && !isClassic) {
+        state.numCalls--;
+        return true;
     } else {
-        return "";
+        return false;
     }
 }
 
-bool Player::IsValidCoord(const vector<vector<int>>& board, const vector<int>& coord) const {
-    int row = coord[ROW_INDEX];
-    int col = coord[COL_INDEX];
-
-    if ((row >= 0 && row <= MAX_SIZE - 1) && (col >= 0 && col <= MAX_SIZE - 1)) { // Within bounds
-        if (board[row][col] == NOTHING_INT) {
+bool Player::IsValidCoord(const Board& board, Coord coord) const {
+    if (coord.IsOnBoard()) { // Within bounds
+        if (board.IsEmpty(coord.row, coord.col)) {
             return true;
         } else {
             return false;
@@ -428,174 +274,112 @@ bool Player::IsValidCoord(const vector<vector<int>>& board, const vector<int>& c
     }
 }
 
-bool Player::IsValidCoord(const vector<vector<int>>& board, const vector<int>& coord, int length, string direction) const {
-    int row = coord[ROW_INDEX];
-    int col = coord[COL_INDEX];
-    
-    if (IsValidCoord(board, coord)) { // Within bounds and empty
-        for (int i = 0; i < length; i++) { // Iterate over grid and check values after first checking if out of bounds
-            int boardValue = board[row][col];
-
-            if (boardValue == SHIP_INT) {
-                return false;
-            }
+bool Player::IsValidCoord(const Board& board, Coord coord, int length, Ship::Direction direction) const {
+    if (!IsValidCoord(board, coord)) { // Within bounds and empty
+        return false;
+    }
 
-            if (direction == Ship::NORTH) {
-                if (row - 1 < 0 && i < length - 1) { // Make sure that coordinate isn't on its last iteration -- it's still valid
-                    return false;
-                }
-                row--;
-            } else if (direction == Ship::EAST && i < length - 1) {
-                if (col + 1 >= MAX_SIZE) {
-                    return false;
-                }
-                col++;
-            } else if (direction == Ship::SOUTH && i < length - 1) {
-                if (row + 1 >= MAX_SIZE) {
-                    return false;
-                }
-                row++;
-            } else {
-                if (col - 1 < 0 && i < length - 1) {
-                    return false;
-                }
-                col--;
-            }
-        }
+    // Only this placement's cells matter, so they are checked directly; PlaceRandomShip uses the whole-board masks.
+    int row = coord.row;
+    int col = coord.col;
+    int endRow = row + Ship::ROW_DELTAS[direction] * (length - 1);
+    int endCol = col + Ship::COL_DELTAS[direction] * (length - 1);
 
-        return true;
-    } else {
+    if (endRow < 0 || endRow >= MAX_SIZE || endCol < 0 || endCol >= MAX_SIZE) {
         return false;
     }
-}
 
-vector<int> Player::PromptUserCoord() const {
-    vector<int> coord;
-    bool valid = false;
-    string userStr;
-    cout << "\n";
-    
-    do {
-        vector<int> newCoord;
-        coord = newCoord;
-
-        cout << "Please enter a valid coordinate (ex: A1): ";
-        getline(cin, userStr);
-        
-        if (userStr.length() >= NUM_DIMENSIONS) {
-            char rowChar = toupper(userStr[0]);
-            int row;
-            bool foundChar = false;
-
-            for (int i = 0; i < MAX_SIZE; i++) {
-                if (letters[i] == rowChar) {
-                    row = i;
-                    foundChar = true;
-                    break;
-                }
-            }
-
-            string colStr = userStr.substr(1);
-            int col;
-            bool colIsInt = true;
+    int first = Bitboard::Index(min(row, endRow), min(col, endCol));
+    Bitboard cells = Bitboard::Run(first, length, Ship::ROW_DELTAS[direction] != 0);
+    return (cells & board.GetPlane(SHIP_INT)) == Bitboard();
+}
 
-            for (int i = 0; i < colStr.length(); i++) { // Checks if the rest of the string are numbers
-                if (!isdigit(colStr.at(i))) {
-                    colIsInt = false;
-                }
-            }
-            
-            if (colIsInt) {
-                col = stoi(colStr) - 1; // Convert for easy use with array
-            }
+Coord Player::PromptComputerCoord() {
+    BATTLESHIP_TIME(instrument, PROMPT_TIMER);
+    Coord coord = PickComputerCoord();
 
-            if (foundChar && colIsInt) {
-                coord.push_back(row);
-                coord.push_back(col);
-                valid = IsValidCoord(offensiveBoard, coord);
-            }
-        }
+    // A hard search can step past an edge or onto a cell called before; it moves on to its next pick right away.
+    while (!IsValidCoord(state.offensiveBoard, coord)) {
+        BATTLESHIP_COUNT(instrument, CALL_RETRIES);
+        coord = PickComputerCoord();
+    }
 
-        if (!valid) {
-            cout << "Sorry, invalid coordinate. ";
-        }
-    } while (!valid);
-    
     return coord;
 }
 
-vector<int> Player::PromptComputerCoord() {
-    vector<int> coord; 
+Coord Player::PickComputerCoord() {
+    Coord coord;
 
-    if (settingUpShips) { // Coords procedure while setting up ships
-        coord = GetRandCoord();
+    if (difficulty == EXPERT) {
+        coord = GetDensityCoord();
+    } else if (difficulty == MONTE_CARLO) {
+        coord = GetSampledCoord();
     } else { 
-        if (isHardmode && searches.empty()) { // First check if there are hit coordinates to bounce off of.
+        bool isHardmode = (difficulty == HARD);
+
+        if (isHardmode && state.numSearches == 0) { // First check if there are hit coordinates to bounce off of.
             bool foundHitCoord = false;
             SearchData tempSd;
-            for (int i = 0; i < MAX_SIZE; i++) {
-                for (int j = 0; j < MAX_SIZE; j++) {
-                    if (offensiveBoard[i][j] == HIT_INT) {
-                        foundHitCoord = true;
-                        SearchData newSd;
-                        tempSd = newSd;
-                        vector<int> searchCoord;
-                        
-                        searchCoord.push_back(i);
-                        searchCoord.push_back(j);
-                        tempSd.startPos = searchCoord;
-                        tempSd.possibleDirs = GetPossibleDirs(searchCoord);
-
-                        // Only use a hit that isn't surrounded by previous shots.
-                        if (tempSd.possibleDirs.size() > 0) {
-                            tempSd.currDir = GetRandDir(tempSd);
-                            tempSd.startPos = searchCoord;
-                            tempSd.currPos = GetNext(searchCoord, tempSd.currDir);
-                            tempSd.futurePos = tempSd.currPos;
-                            tempSd.previousPos.push_back(tempSd.currPos);
-                            searches.push_back(tempSd);
-                        }
-                    }
+            Bitboard hitCells = state.offensiveBoard.GetPlane(HIT_INT);
+            while (hitCells.Any()) { // Visit hits in row-major order
+                int index = hitCells.PopFirst();
+                foundHitCoord = true;
+                SearchData newSd;
+                tempSd = newSd;
+                Coord searchCoord = Coord::FromIndex(index);
+                tempSd.startPos = searchCoord;
+                tempSd.numPossibleDirs = GetPossibleDirs(searchCoord, tempSd.possibleDirs);
+
+                // Only use a hit that isn't surrounded by previous shots.
+                if (tempSd.numPossibleDirs > 0) {
+                    tempSd.currDir = GetRandDir(tempSd);
+                    tempSd.startPos = searchCoord;
+                    tempSd.currPos = GetNext(searchCoord, tempSd.currDir);
+                    tempSd.futurePos = tempSd.currPos;
+                    tempSd.previousPos.Set(tempSd.currPos.GetIndex());
+                    state.searches[state.numSearches] = tempSd;
+                    BATTLESHIP_COUNT(instrument, SEARCHES_CREATED);
+                    state.numSearches++;
                 }
             }
             
-            if (foundHitCoord) {
-                return tempSd.currPos;
+            if (foundHitCoord && state.numSearches > 0) { // Hits that are surrounded by previous shots don't start a search
+                return state.searches[state.numSearches - 1].currPos;
             }
         }
 
-        if (!isHardmode || (isHardmode && searches.empty())) { // Default decision for coordinate calling
+        if (!isHardmode || (isHardmode && state.numSearches == 0)) { // Default decision for coordinate calling
             coord = GetRandCoord();
         } else { // Procedure for hardmode and searching for a likely coordinate
             AssignShipsToSearch();
             bool finishSearch = false;
             int randInd = GetRandSearchData();
-            SearchData& sd = searches[randInd];
+            SearchData& sd = state.searches[randInd];
             bool validCurrDir = true;
             
             if (sd.futurePos != sd.currPos) { // Check if the current position is going to go out of bounds
-                if (IsValidCoord(offensiveBoard, sd.futurePos) || (!IsValidCoord(offensiveBoard, sd.futurePos) && IsValidCoord(offensiveBoard, sd.currPos))) {
+                if (IsValidCoord(state.offensiveBoard, sd.futurePos) || (!IsValidCoord(state.offensiveBoard, sd.futurePos) && IsValidCoord(state.offensiveBoard, sd.currPos))) {
                     validCurrDir = true;
                 } else {
                     validCurrDir = false;
                 }
             }
 
-            if (!sd.currDirSuccess && sd.possibleDirs.size() > 0) {
+            if (!sd.currDirSuccess && sd.numPossibleDirs > 0) {
                 FinishDir(sd);
 
-                if (sd.possibleDirs.size() == 0) {
+                if (sd.numPossibleDirs == 0) {
                     finishSearch = true;
                 } else {
                     finishSearch = false;
                 }
-            } else if (!sd.currDirSuccess && sd.possibleDirs.empty()) {
+            } else if (!sd.currDirSuccess && sd.numPossibleDirs == 0) {
                 finishSearch = true;
             } else { // Continue calling in the same direction unless it is out of bounds
                 if (!validCurrDir) { // Either the current position is out of bounds or already called during salvo
                     FinishDir(sd);
                     
-                    if (sd.possibleDirs.size() > 0) {
+                    if (sd.numPossibleDirs > 0) {
                         finishSearch = false;
                     } else {
                         finishSearch = true;
@@ -604,13 +388,17 @@ vector<int> Player::PromptComputerCoord() {
             }
 
             if (finishSearch) {
-                searches.clear();
+                state.numSearches = 0;
                 coord = GetRandCoord();
             } else {
                 coord = sd.currPos;
                 sd.currPos = GetNext(sd.currPos, sd.currDir);
                 sd.futurePos = GetNext(sd.currPos, sd.currDir);
-                sd.previousPos.push_back(coord);
+
+                if (coord.IsOnBoard()) { // A search can step past an edge, and such a call is never shot
+                    sd.previousPos.Set(coord.GetIndex());
+                }
+
                 UpdPriorities();
             }
         }
@@ -619,73 +407,136 @@ vector<int> Player::PromptComputerCoord() {
     return coord;
 }
 
-vector<int> Player::GetRandCoord() const {
-    vector<int> coord; 
-    int randRow = rand() % MAX_SIZE;
-    int randCol = rand() % MAX_SIZE;
-    coord.push_back(randRow);
-    coord.push_back(randCol);
-    return coord;
+Coord Player::GetDensityCoord() {
+    // Only cells that haven't been called can be picked; ties are broken randomly.
+    Bitboard best = state.density.GetDensestCells(state.offensiveBoard.GetEmpty());
+    return Coord::FromIndex(best.Select(state.rng.NextInt(best.Count())));
+}
+
+Coord Player::GetSampledCoord() {
+    const int NUM_CELLS = MAX_SIZE * MAX_SIZE;
+
+    // Gather the ships that are still afloat.
+    int lengths[MAX_SHIPS];
+    int numAfloat = 0;
+
+    for (int i = 0; i < MAX_SHIPS; i++) {
+        if ((state.opponentShipsSunk & (1u << i)) == 0) {
+            lengths[numAfloat] = SHIP_LENGTHS[i];
+            numAfloat++;
+        }
+    }
+
+    Bitboard blocked = state.offensiveBoard.GetPlane(MISS_INT) | state.offensiveBoard.GetPlane(SUNKEN_INT);
+    int counts[NUM_CELLS];
+    int accepted = FleetSampler::CountShips(lengths, numAfloat, blocked, state.offensiveBoard.GetPlane(HIT_INT), samplerBudget,
+                                            state.rng.Next(), counts);
+
+    if (accepted == 0) {
+        return GetDensityCoord();
+    }
+
+    // Only cells that haven't been called can be picked; ties are broken randomly.
+    Bitboard targets = state.offensiveBoard.GetEmpty();
+    Bitboard best;
+    int bestCount = -1;
+
+    while (targets.Any()) {
+        int index = targets.PopFirst();
+
+        if (counts[index] > bestCount) {
+            bestCount = counts[index];
+            best = Bitboard();
+        }
+
+        if (counts[index] == bestCount) {
+            best.Set(index);
+        }
+    }
+
+    return Coord::FromIndex(best.Select(state.rng.NextInt(best.Count())));
+}
+
+bool Player::TracksDensity() const {
+    return difficulty == EXPERT || difficulty == MONTE_CARLO;
 }
 
-vector<string> Player::GetPossibleDirs(const vector<int>& coord) const {
-    vector<string> dirs;
+Coord Player::GetRandCoord() {
+    // Draw straight from the cells that haven't been called, so a pick never has to be retried.
+    Bitboard uncalled = state.offensiveBoard.GetEmpty();
+    return Coord::FromIndex(uncalled.Select(state.rng.NextInt(uncalled.Count())));
+}
 
-    if (IsValidCoord(offensiveBoard, {coord[ROW_INDEX] - 1, coord[COL_INDEX]})) {
-        dirs.push_back(Ship::NORTH);
+int Player::GetPossibleDirs(Coord coord, Ship::Direction dirs[]) const {
+    int numDirs = 0;
+    Bitboard emptyCells = state.offensiveBoard.GetEmpty();
+    int index = coord.GetIndex();
+
+    // Shifting the empty cells toward coord lines each neighbour up with it; off-board neighbours shift in as zero.
+    if (emptyCells.ShiftSouth().Test(index)) {
+        dirs[numDirs] = Ship::NORTH;
+        numDirs++;
     }
 
-    if (IsValidCoord(offensiveBoard, {coord[ROW_INDEX], coord[COL_INDEX] + 1})) {
-        dirs.push_back(Ship::EAST);
+    if (emptyCells.ShiftWest().Test(index)) {
+        dirs[numDirs] = Ship::EAST;
+        numDirs++;
     }
 
-    if (IsValidCoord(offensiveBoard, {coord[ROW_INDEX] + 1, coord[COL_INDEX]})) {
-        dirs.push_back(Ship::SOUTH);
+    if (emptyCells.ShiftNorth().Test(index)) {
+        dirs[numDirs] = Ship::SOUTH;
+        numDirs++;
     }
 
-    if (IsValidCoord(offensiveBoard, {coord[ROW_INDEX], coord[COL_INDEX] - 1})) {
-        dirs.push_back(Ship::WEST);
+    if (emptyCells.ShiftEast().Test(index)) {
+        dirs[numDirs] = Ship::WEST;
+        numDirs++;
     }
 
-    return dirs;
+    return numDirs;
 }
 
-string Player::GetRandDir(const SearchData sd) const {
-    return sd.possibleDirs[rand() % sd.possibleDirs.size()];
+Ship::Direction Player::GetRandDir(const SearchData& sd) {
+    return sd.possibleDirs[state.rng.NextInt(sd.numPossibleDirs)];
 }
 
 void Player::FinishDir(SearchData& sd) {
-    if (sd.possibleDirs.size() > 0) {
-        string lastDir = sd.currDir;
+    BATTLESHIP_COUNT(instrument, DIRECTIONS_FINISHED);
+
+    if (sd.numPossibleDirs > 0) {
+        Ship::Direction lastDir = sd.currDir;
         bool pickRandDir = true;
         int add = 0;
 
-        for (int i = 0; i < sd.possibleDirs.size(); i++) {
+        for (int i = 0; i < sd.numPossibleDirs; i++) {
             if (sd.possibleDirs[i] == lastDir) {
                 add = i;
                 break;
             }
         }
 
-        sd.possibleDirs.erase(sd.possibleDirs.begin() + add);
+        for (int i = add + 1; i < sd.numPossibleDirs; i++) { // Keep the remaining directions in order
+            sd.possibleDirs[i - 1] = sd.possibleDirs[i];
+        }
+
+        sd.numPossibleDirs--;
 
         // Use a direction in the same axis. Otherwise, randomize the next direction.
-        if (lastDir == Ship::NORTH && IsValidCoord(offensiveBoard, {sd.startPos[ROW_INDEX] + 1, sd.startPos[COL_INDEX]})) {
-            sd.currDir = Ship::SOUTH;
-            pickRandDir = false;
-        } else if (lastDir == Ship::SOUTH && IsValidCoord(offensiveBoard, {sd.startPos[ROW_INDEX] - 1, sd.startPos[COL_INDEX]})) {
-            sd.currDir = Ship::NORTH;
-            pickRandDir = false;
-        } else if (lastDir == Ship::EAST && IsValidCoord(offensiveBoard, {sd.startPos[ROW_INDEX], sd.startPos[COL_INDEX] - 1})) {
-            sd.currDir = Ship::WEST;
-            pickRandDir = false;
-        } else if (lastDir == Ship::WEST && IsValidCoord(offensiveBoard, {sd.startPos[ROW_INDEX], sd.startPos[COL_INDEX] + 1})) {
-            sd.currDir = Ship::EAST;
+        Ship::Direction oppositeDir = Ship::GetOpposite(lastDir);
+
+        if (IsValidCoord(state.offensiveBoard, GetNext(sd.startPos, oppositeDir))) {
+            sd.currDir = oppositeDir;
             pickRandDir = false;
         }
     
-        if (pickRandDir && sd.possibleDirs.size() > 0) {
-            sd.possibleDirs = GetPossibleDirs(sd.startPos);
+        if (pickRandDir && sd.numPossibleDirs > 0) {
+            sd.numPossibleDirs = GetPossibleDirs(sd.startPos, sd.possibleDirs);
+
+            if (sd.numPossibleDirs == 0) { // Every side of the start has been called since the search began
+                sd.currDirSuccess = false;
+                return;
+            }
+
             sd.currDir = GetRandDir(sd);
         } 
 
@@ -696,29 +547,17 @@ void Player::FinishDir(SearchData& sd) {
     }
 }
 
-vector<int> Player::GetNext(const vector<int>& coord, string direction) const {
-    vector<int> newCoord = {coord[ROW_INDEX], coord[COL_INDEX]};
-
-    if (direction == Ship::NORTH) {
-        newCoord[ROW_INDEX]--;
-    } else if (direction == Ship::EAST) {
-        newCoord[COL_INDEX]++;
-    } else if (direction == Ship::SOUTH) {
-        newCoord[ROW_INDEX]++;
-    } else {
-        newCoord[COL_INDEX]--;
-    }
-
-    return newCoord;
+Coord Player::GetNext(Coord coord, Ship::Direction direction) const {
+    return Coord(coord.row + Ship::ROW_DELTAS[direction], coord.col + Ship::COL_DELTAS[direction]);
 }
 
 int Player::GetRandSearchData() const {
     int minInd = 0;
 
     // Chooses the index that yields the least priority, unless the index is negative
-    for (int i = 0; i < searches.size(); i++) {
-        int possiblePriority = searches[i].priority;
-        int minPriority = searches[minInd].priority;
+    for (int i = 0; i < state.numSearches; i++) {
+        int possiblePriority = state.searches[i].priority;
+        int minPriority = state.searches[minInd].priority;
         if (abs(possiblePriority) < abs(minPriority)) {
             minInd = i;
         }
@@ -727,14 +566,10 @@ int Player::GetRandSearchData() const {
     return minInd;
 }
 
-int Player::GetSearchData(const vector<int>& coord) const {
-    for (int i = 0; i < searches.size(); i++) {
-        SearchData sd = searches[i];
-
-        for (int j = 0; j < sd.previousPos.size(); j++) {
-            if (sd.previousPos[j] == coord) {
-                return i;
-            }
+int Player::GetSearchData(Coord coord) const {
+    for (int i = 0; i < state.numSearches; i++) {
+        if (state.searches[i].previousPos.Test(coord.GetIndex())) {
+            return i;
         }
     }
 
@@ -742,18 +577,19 @@ int Player::GetSearchData(const vector<int>& coord) const {
 }
 
 void Player::AssignShipsToSearch() {
-    if (!searches.empty() && !shipsHit.empty()) {
-        for (SearchData& sd : searches) { // Go through every search
+    if (state.numSearches > 0 && state.numShipsHit > 0) {
+        for (int searchInd = 0; searchInd < state.numSearches; searchInd++) { // Go through every search
+            SearchData& sd = state.searches[searchInd];
             bool foundShip = false;
             int spacesLeft;
 
             int count = 0;
-            while (!foundShip && count < shipsHit.size()) { // Go through every ship and its hit coordinates to try to match search
-                Ship ship = shipsHit[count];
-                vector<vector<int>> shipHitCoords = ship.GetHitCoords();
+            while (!foundShip && count < state.numShipsHit) { // Go through every ship and its hit coordinates to try to match search
+                const Ship& ship = state.shipsHit[count];
+                const Coord* shipHitCoords = ship.GetHitCoords();
                 spacesLeft = ship.GetLength();
 
-                for (int i = 0; i < shipHitCoords.size(); i++) {
+                for (int i = 0; i < ship.GetNumHitCoords(); i++) {
                     if (shipHitCoords[i] == sd.startPos) { // Decrease the spaces left for every hit coordinate
                         foundShip = true;
                         spacesLeft--;
@@ -767,137 +603,102 @@ void Player::AssignShipsToSearch() {
             sd.priority = sd.spacesLeft;
         }
 
-        shipsHit.clear();
+        state.numShipsHit = 0;
     }
 }
 
 void Player::UpdPriorities() {
-    for (SearchData& sd : searches) {
-        sd.priority--;
+    for (int i = 0; i < state.numSearches; i++) {
+        state.searches[i].priority--;
     }
 }
 
-string Player::ShootCoord(const vector<int>& coord, Player& opponent) {
-    int row = coord[ROW_INDEX];
-    int col = coord[COL_INDEX];
+Player::ShotResult Player::ShootCoord(Coord coord, Player& opponent) {
+    BATTLESHIP_TIME(instrument, SHOOT_TIMER);
+    BATTLESHIP_COUNT(instrument, SHOTS);
+    int row = coord.row;
+    int col = coord.col;
     
-    // Find if a ship was hit and, if so, its name.
-    vector<vector<int>> opponentBoard = opponent.GetShipBoard();
-    vector<Ship*> opponentShips = opponent.GetShips();
-    string status = "";
-
-    bool opponentShipFound = false;
-    int count = 0;
-
-    if (opponentBoard[row][col] == SHIP_INT) {
-        prevTurnHits.push_back(coord);
-        if (searches.size() > 0) {
+    // Find if a ship was hit.
+    ShotResult result;
+    result.coord = coord;
+    result.shipId = opponent.GetShipAt(row, col);
+
+    if (result.shipId != NO_SHIP) {
+        state.prevTurnHits[state.numPrevTurnHits] = coord;
+        state.numPrevTurnHits++;
+        if (state.numSearches > 0) {
             int ind = GetSearchData(coord);
-            searches[ind].currDirSuccess = true;
+            state.searches[ind].currDirSuccess = true;
         }
 
-        while (!opponentShipFound && count < MAX_SHIPS) { // Iterate through ship vector, checking which one was hit
-            Ship* opponentShip = opponent.GetShips()[count];
-            string opponentShipName = opponentShip->GetName();
-            vector<vector<int>> shipCoords = opponentShip->GetCoords();
-            
-            for (int i = 0; i < opponentShip->GetLength(); i++) { // Iterate through ship coordinates
-                vector<int> shipCoord = shipCoords[i];
-                int shipRow = shipCoord[ROW_INDEX];
-                int shipCol = shipCoord[COL_INDEX];
-
-                if (row == shipRow && col == shipCol) { // Ship has been found
-                    status += "hit on " + opponentShipName + "!";
-                    opponent.SetShipBoard(row, col, HIT_INT);
-                    offensiveBoard[row][col] = HIT_INT;
-                    opponentShip->SetHitCoord(coord);
-                    hitCount++;
-                    opponentShipFound = true;
-                    shipsHit.push_back(*opponentShip); // Save the ship data so that its HP can be assigned to a search
-
-                    if (opponentShip->IsShipSunk()) { // Ship has sunken.
-                        status += "\n" + opponentShipName + " has been sunk!";
-                        status += opponent.LowerTurn(); // Lower turn for Salvo gamemode
-                        opponent.IncShipsLost();
-                        shipsDestroyed++;
-                        searches.clear();
-
-                        for (vector<int> hitCoord : opponentShip->GetHitCoords()) { // Set player and opponent coordinates to sunken
-                            int hitCoordRow = hitCoord[ROW_INDEX];
-                            int hitCoordCol = hitCoord[COL_INDEX];
-                            opponent.SetShipBoard(hitCoordRow, hitCoordCol, SUNKEN_INT);
-                            offensiveBoard[hitCoordRow][hitCoordCol] = SUNKEN_INT;
-                        }
-                    }
+        Ship* opponentShip = opponent.GetShip(result.shipId);
+        opponent.SetShipBoard(row, col, HIT_INT);
+        state.offensiveBoard.Set(row, col, HIT_INT);
+        opponentShip->SetHitCoord(coord);
+        state.hitCount++;
+        state.shipsHit[state.numShipsHit] = *opponentShip;
+        state.numShipsHit++; // Save the ship data so that its HP can be assigned to a search
 
-                    break;
-                }
+        if (TracksDensity()) {
+            state.density.AddHit(Bitboard::Index(row, col));
+        }
+
+        if (opponentShip->IsShipSunk()) { // Ship has sunken.
+            result.sunk = true;
+            state.opponentShipsSunk |= 1u << result.shipId;
+            result.callsLowered = opponent.LowerTurn(); // Lower turn for Salvo gamemode
+            opponent.IncShipsLost();
+            state.shipsDestroyed++;
+            state.numSearches = 0;
+            Bitboard sunkCells;
+
+            for (int i = 0; i < opponentShip->GetNumHitCoords(); i++) { // Set player and opponent coordinates to sunken
+                Coord hitCoord = opponentShip->GetHitCoords()[i];
+                opponent.SetShipBoard(hitCoord.row, hitCoord.col, SUNKEN_INT);
+                state.offensiveBoard.Set(hitCoord.row, hitCoord.col, SUNKEN_INT);
+                sunkCells.Set(hitCoord.GetIndex());
             }
 
-            count++;
+            if (TracksDensity()) {
+                state.density.AddSunk(result.shipId, sunkCells);
+            }
         }
     } else {
-        status += "miss.";
-        offensiveBoard[row][col] = MISS_INT;
-        if (searches.size() > 0) {
-            int ind = GetSearchData(coord);
-            searches[ind].currDirSuccess = false;
+        state.offensiveBoard.Set(row, col, MISS_INT);
+
+        if (TracksDensity()) {
+            state.density.AddMiss(Bitboard::Index(row, col));
         }
-    }
-    
-    char rowChar;
-    for (int i = 0; i < MAX_SIZE; i++) { // Convert row to char
-        if (row == i) {
-            rowChar = letters[i];
+
+        if (state.numSearches > 0) {
+            int ind = GetSearchData(coord);
+            state.searches[ind].currDirSuccess = false;
         }
     }
     
-    callCount++;
-    string result = "";
-    result += rowChar + to_string(col + 1) + " was a " + status + "\n"; // Increase col by one (index is 1 less)
+    state.callCount++;
     return result;
 }
 
-string Player::PromptUserOrientation() const {
-    string userOrtn;
-    bool foundOrientation = false;
-
-    do {
-        cout << "Please enter a valid ship orientation (ex: NORTH): ";
-        getline(cin, userOrtn);
-
-        for (int i = 0; i < userOrtn.length(); i++) { // toupper() string
-            userOrtn[i] = toupper(userOrtn[i]);
-        }
-
-        for (int i = 0; i < Ship::ORIENTATIONS.size(); i++) {
-            string orientation = Ship::ORIENTATIONS[i];
-            if (userOrtn == orientation) {
-                foundOrientation = true;
-                break;
-            }
-        }
-
-        if (!foundOrientation) {
-            cout << "Sorry, invalid orientation. ";
-        }
-    } while (!foundOrientation);
-
-    return userOrtn;
-}
-
 int Player::GetShipsDestroyed() const {
-    return shipsDestroyed;
+    return state.shipsDestroyed;
 }
 
 int Player::GetHitCount() const {
-    return hitCount;
+    return state.hitCount;
 }
 
 int Player::GetCallCount() const {
-    return callCount;
+    return state.callCount;
 }
 
 double Player::GetAccuracy() const {
-    return (callCount > 0) ? (static_cast<double>(hitCount) / callCount) * 100.0 : 0.0;
-}
\ No newline at end of file
+    return (state.callCount > 0) ? (static_cast<double>(state.hitCount) / state.callCount) * 100.0 : 0.0;
+}
+
+#ifdef BATTLESHIP_INSTRUMENT
+const Instrument::Counters& Player::GetInstrument() const {
+    return instrument;
+}
+#endif
@@ -1,18 +1,98 @@
 #ifndef PLAYER_H
 #define PLAYER_H
 #include "Ship.h"
-#include <vector>
+#include "Coord.h"
+#include "Board.h"
+#include "Random.h"
+#include "DensityMap.h"
+#include "FleetSampler.h"
+#ifdef BATTLESHIP_INSTRUMENT
+#include "Instrument.h"
+#endif
+#include <cstdint>
 #include <string>
+#include <type_traits>
 using namespace std;
 
 class Player {
 public:
+    static const int MAX_SHIPS = 5;
+    static const int MAX_SIZE = 10;
+    static const int NO_SHIP = -1;
+    static const char* const SHIP_NAMES[MAX_SHIPS];
+    static const int SHIP_LENGTHS[MAX_SHIPS];
+    static const int FLEET_SPACES = Ship::DESTROYER_HP + Ship::SUBMARINE_HP + Ship::CRUISER_HP + Ship::BATTLESHIP_HP +
+                                    Ship::CARRIER_HP; // Spaces the whole fleet occupies
+
+    /**
+     * How the computer picks its shots.
+     */
+    enum Difficulty {
+        EASY, // Random shots
+        HARD, // Random shots, then searches outward from hits
+        EXPERT, // Shoots the cell covered by the most possible placements of the remaining ships
+        MONTE_CARLO // Samples whole fleet layouts that fit the shots so far and shoots where ships turn up most often
+    };
+
+    /**
+     * Outcome of one called coordinate once it has been shot.
+     */
+    struct ShotResult {
+        Coord coord;
+        int shipId = NO_SHIP; // Opponent ship that was hit, or NO_SHIP for a miss
+        bool sunk = false;
+        bool callsLowered = false; // Whether sinking the ship cost the opponent a call (salvo)
+    };
+
+    /**
+     * A hard computer's search outward from one of its hits.
+     */
+    struct SearchData {
+        Coord startPos;
+        Coord currPos;
+        Coord futurePos;
+        Bitboard previousPos; // Cells the search has called
+        Ship::Direction possibleDirs[Ship::NUM_DIRECTIONS];
+        int numPossibleDirs = 0;
+        Ship::Direction currDir = Ship::NORTH;
+        bool currDirSuccess = true;
+        int spacesLeft = -1;
+        int priority = -1;
+    };
+
+    /**
+     * Everything about a player that changes during a game: boards, fleet, searches, counters and the random generator.
+     * It is plain data with fixed capacities, so taking or restoring a snapshot is a single memcpy.
+     */
+    struct State {
+        int numCalls;
+        Board offensiveBoard;
+        Board shipBoard;
+        bool settingUpShips;
+        int callCount;
+        int hitCount;
+        Coord prevTurnHits[FLEET_SPACES];
+        int numPrevTurnHits;
+        Coord pendingCalls[MAX_SHIPS]; // Coordinates called this turn that have not been shot yet
+        int numPendingCalls;
+        int pendingHits;
+        Ship ships[MAX_SHIPS]; // In placement order
+        int numShips;
+        signed char shipIndex[MAX_SIZE * MAX_SIZE]; // Index into ships for every cell of shipBoard, or NO_SHIP
+        int shipsDestroyed;
+        int shipsLost;
+        unsigned int opponentShipsSunk; // Bit i is set once the opponent's ship i has been sunk
+        DensityMap density; // Placements of the opponent's fleet still possible; only kept up to date if TracksDensity()
+        SearchData searches[FLEET_SPACES]; // A search starts from a hit, so there is never more than one per fleet space
+        int numSearches;
+        Ship shipsHit[FLEET_SPACES]; // Ships as they were when hit, waiting to be matched to a search
+        int numShipsHit;
+        Random rng;
+    };
+
     Player();
     Player(string playerName, bool isComputer, bool isClassic, bool isHardmode);
 
-    static const int MAX_SHIPS = 5;
-    static const int MAX_SIZE = 10;
-    
     /**
      * Gets player name.
      * @return Player name.
@@ -20,9 +100,85 @@ public:
     string GetName() const;
 
     /**
-     * Allows player to place down MAX_SHIPS down on the board.
+     * Checks if the player is controlled by the computer.
+     * @return Whether or not the player is a computer.
      */
-    void GenerateShips();
+    bool IsComputer() const;
+
+    /**
+     * Checks if the player is playing classic (one call per turn) rather than salvo.
+     * @return Whether or not the mode is classic.
+     */
+    bool IsClassic() const;
+
+    /**
+     * Sets how the computer picks its shots.
+     * @param newDifficulty Difficulty of the computer.
+     */
+    void SetDifficulty(Difficulty newDifficulty);
+
+    /**
+     * Gets how the computer picks its shots.
+     * @return Difficulty of the computer.
+     */
+    Difficulty GetDifficulty() const;
+
+    /**
+     * Sets how much work a MONTE_CARLO computer may do for each shot.
+     * @param budget Sample count, streams and time limit per shot.
+     */
+    void SetSamplerBudget(const FleetSampler::Budget& budget);
+
+    /**
+     * Restarts the player's random number generator, which drives all of the computer's choices.
+     * @param seed Seed of the generator.
+     */
+    void SetSeed(uint64_t seed);
+
+    /**
+     * Gets the seed of the player's random number generator.
+     * @return Seed.
+     */
+    uint64_t GetSeed() const;
+
+    /**
+     * Takes a snapshot of the player's game so it can be restored later, for example to branch a lookahead.
+     * @return The player's state.
+     */
+    State Snapshot() const;
+
+    /**
+     * Puts the player back into a state taken by Snapshot. The name, difficulty and sampler budget are kept.
+     * @param snapshot State to restore.
+     */
+    void Restore(const State& snapshot);
+
+    /**
+     * Clears the player's game so the same player can start a new one, without placed ships.
+     * The name, difficulty, sampler budget and random number generator are kept.
+     */
+    void Reset();
+
+    /**
+     * Places the next ship of the fleet on the board if the placement is valid.
+     * @param shipId Index into SHIP_NAMES/SHIP_LENGTHS; must be the next ship to place.
+     * @param coord Coordinate of the ship's first space.
+     * @param orientation Orientation of ship.
+     * @return Whether or not the ship was placed.
+     */
+    bool PlaceShip(int shipId, Coord coord, Ship::Direction orientation);
+
+    /**
+     * Places the next ship of the fleet, picked uniformly from every legal placement given the ships already placed.
+     * @param shipId Index into SHIP_NAMES/SHIP_LENGTHS; must be the next ship to place.
+     */
+    void PlaceRandomShip(int shipId);
+
+    /**
+     * Checks if all MAX_SHIPS ships have been placed.
+     * @return Whether or not setup is finished.
+     */
+    bool IsSetUp() const;
 
     /**
      * Finds out how many ships were destroyed.
@@ -31,10 +187,47 @@ public:
     int GetShipsDestroyed() const;
 
     /**
-     * It is player's turn: prompt coordinates to call numTurns times and records and announces the result of the shot.
+     * Returns the ships of the player.
+     * @return The first of GetNumShips() ships, in the order they were placed.
+     */
+    const Ship* GetShips() const;
+
+    /**
+     * Gets the number of ships the player has placed.
+     * @return Number of ships.
+     */
+    int GetNumShips() const;
+
+    /**
+     * Calls a coordinate for this turn. Its result is not known until ResolveCalls.
+     * @param coord Coordinate to call.
+     * @param opponent Opponent of player.
+     * @return Whether or not the coordinate was accepted (on the board and not called before).
+     */
+    bool CallCoord(Coord coord, Player& opponent);
+
+    /**
+     * Checks if the player has used all their calls for the turn, or has already called every remaining ship space.
      * @param opponent Opponent of player.
+     * @return Whether or not the turn's calls should be resolved.
      */
-    void Turn(Player& opponent);
+    bool IsTurnOver(Player& opponent);
+
+    /**
+     * Shoots every coordinate called this turn, in the order they were called.
+     * @param opponent Opponent of player.
+     * @param results Filled with the result of each call; needs room for MAX_SHIPS.
+     * @return Number of results.
+     */
+    int ResolveCalls(Player& opponent, ShotResult results[]);
+
+    /**
+     * Creates random coordinates for the computer.
+     * If the computer is in hardmode, coordinates adjacent to previous hits (not surrounded by previous shots) will be chosen.
+     * Expert and Monte Carlo computers shoot where the opponent's remaining ships are most likely to be.
+     * @return Coordinate to call, always on the board and not called before.
+     */
+    Coord PromptComputerCoord();
 
     /**
      * Gets the number of hits the player has gotten.
@@ -53,53 +246,67 @@ public:
      * @return Accuracy as a double.
      */
     double GetAccuracy() const;
-    
+
+#ifdef BATTLESHIP_INSTRUMENT
     /**
-     * Deletes all ship objects.
+     * Gets the counters and timers of the player's hot paths since the game started.
+     * @return The player's counters.
      */
-    void DeleteShips();
+    const Instrument::Counters& GetInstrument() const;
+#endif
+
+
+    // Console front-end (PlayerConsole.cpp). Nothing above this line reads from or writes to the terminal.
+
+    /**
+     * Allows player to place down MAX_SHIPS down on the board.
+     */
+    void GenerateShips();
+
+    /**
+     * Prompts user for coordinates within the grid.
+     * @return Coordinate that is on the board and hasn't been called.
+     */
+    Coord PromptUserCoord() const;
+
+    /**
+     * Shows the player's boards and announces where the opponent hit their fleet last turn.
+     * @param opponent Opponent of player.
+     */
+    void AnnounceTurn(Player& opponent);
+
+    /**
+     * Shows the player's shots and announces the result of each call.
+     * @param results The resolved calls of the turn.
+     * @param numResults Number of results.
+     * @param opponent Opponent of player.
+     */
+    void AnnounceResults(const ShotResult results[], int numResults, Player& opponent) const;
 private:
-    const int ROW_INDEX = 0;
-    const int COL_INDEX = 1;
+#ifdef BATTLESHIP_BENCH
+    friend class PlayerBench; // bench.cpp times private methods directly; only benchmark builds define this
+#endif
+
     const int NUM_DIMENSIONS = 2;
     const char STARTING_LETTER = 'A';
-    const int TEMP_INT = -2;
-    const int NOTHING_INT = -1;
-    const int MISS_INT = 0;
-    const int HIT_INT = 1;
-    const int SHIP_INT = 2;
-    const int SUNKEN_INT = 3;
+    const int TEMP_INT = Board::TEMP_INT;
+    const int NOTHING_INT = Board::NOTHING_INT;
+    const int MISS_INT = Board::MISS_INT;
+    const int HIT_INT = Board::HIT_INT;
+    const int SHIP_INT = Board::SHIP_INT;
+    const int SUNKEN_INT = Board::SUNKEN_INT;
 
     string name;
     bool isComputer;
     bool isClassic;
 
-    bool isHardmode;
-    struct SearchData {
-        vector<int> startPos;
-        vector<int> currPos;
-        vector<int> futurePos;
-        vector<vector<int>> previousPos;
-        vector<string> possibleDirs;
-        string currDir = "";
-        bool currDirSuccess = true;
-        int spacesLeft = -1;
-        int priority = -1;
-    };
-    vector<SearchData> searches;
-    vector<Ship> shipsHit;
-
-    int numCalls;
+    Difficulty difficulty;
+    FleetSampler::Budget samplerBudget;
     char letters[MAX_SIZE];
-    vector<vector<int>> offensiveBoard;
-    vector<vector<int>> shipBoard;
-    bool settingUpShips;
-    int callCount;
-    int hitCount;
-    vector<vector<int>> prevTurnHits;
-    vector<Ship*> ships;
-    int shipsDestroyed;
-    int shipsLost;
+    State state;
+#ifdef BATTLESHIP_INSTRUMENT
+    Instrument::Counters instrument; // Kept out of State so snapshots don't rewind it
+#endif
 
     /**
      * Assigns all the letters in order to LETTERS (A-J).
@@ -107,17 +314,9 @@ private:
     void MakeLetters();
 
     /**
-     * Sets all elements of board to -1 (nothing).
-     */
-    void GenerateEmptyBoard(vector<vector<int>>& board);
-
-    /**
-     * Displays a battleship board with its name.
-     * @param board The board of a player.
-     * @param info Additional info about the board.
-     * @param showLost Whether or not the number of ships the player has lost will be shown.
+     * Sets every cell of shipIndex to NO_SHIP.
      */
-    void DisplayBoard(const vector<vector<int>>& board, string info, bool showLost) const;
+    void ClearShipIndex();
 
     /**
      * Sets a coordinate of player's ship board to a particular value.
@@ -129,23 +328,34 @@ private:
 
     /**
      * Gets the player's board containing the ships.
-     * @return Vector in vector representing battleship grid.
+     * @return Board representing battleship grid.
      */
-    vector<vector<int>> GetShipBoard() const;
+    const Board& GetShipBoard() const;
 
     /**
-     * Returns the ships of the player.
+     * Gets one of the player's ships.
+     * @param shipId Index of the ship in the order it was placed.
+     * @return The ship.
      */
-    vector<Ship*> GetShips();
+    Ship* GetShip(int shipId);
+
+    /**
+     * Finds which ship occupies a cell, using the index built when ships are placed.
+     * @param row Row of coordinate.
+     * @param col Column of coordinate.
+     * @return Index of the ship, or NO_SHIP if the cell is open water.
+     */
+    int GetShipAt(int row, int col) const;
 
     /**
      * Makes a ship with given data on the board and assigns the coordinates to Ship object too.
      * @param name Name of the ship.
      * @param length Length of ship.
-     * @param coord Row and column in vector.
+     * @param coord Coordinate of the ship's first space.
      * @param orientation Orientation of ship.
+     * @return The ship, to be stored at the next free slot of ships.
      */
-    Ship* CreateShip(string name, int length, const vector<int>& coord, string orientation);
+    Ship CreateShip(const char* name, int length, Coord coord, Ship::Direction orientation);
 
     /**
      * Gets the number of ship spaces opponent has left.
@@ -156,9 +366,15 @@ private:
 
     /**
      * Gets the coordinates that were hit in the previous turn.
-     * @return A vector of the previous coordinates that were hit.
+     * @return The first of GetNumHitsPrev() coordinates, in the order they were hit.
      */
-    vector<vector<int>> GetHitsPrev() const;
+    const Coord* GetHitsPrev() const;
+
+    /**
+     * Gets the number of coordinates that were hit in the previous turn.
+     * @return Number of hits.
+     */
+    int GetNumHitsPrev() const;
 
     /**
      * Resets the counter for times the player has hit their opponent's ships previously.
@@ -179,59 +395,73 @@ private:
 
     /**
      * Decrease the player's number of turns for salvo gamemode.
-     * @return Decrease message in a string.
+     * @return Whether or not the number of turns was decreased.
      */
-    string LowerTurn();
+    bool LowerTurn();
 
     /**
      * Determines if a certain coordinate is valid.
      * @param board Board to be checked.
-     * @param coord Coordinate to check in a vector of row and column.
+     * @param coord Coordinate to check.
      * @return Whether or not the space is valid.
      */
-    bool IsValidCoord(const vector<vector<int>>& board, const vector<int>& coord) const;
+    bool IsValidCoord(const Board& board, Coord coord) const;
     /**
      * Determines if a certain coordinate allows valid coordinates within a given length and direction when setting up ships.
      * @param board The board to check.
-     * @param coord Coordinate to check in a vector of row and column.
+     * @param coord Coordinate to check.
      * @param length Length.
      * @param direction Direction.
      * @return Whether or not the space is valid.
      */
-    bool IsValidCoord(const vector<vector<int>>& board, const vector<int>& coord, int length, string direction) const;
+    bool IsValidCoord(const Board& board, Coord coord, int length, Ship::Direction direction) const;
 
     /**
-     * Prompts user for coordinates within the grid.
-     * @return Coordinate represented as row and column in vector.
+     * Picks the open cell that the most legal placements of the opponent's remaining ships cover, as counted by density.
+     * Placements that cover unsunk hits count extra, so the computer finishes off ships it has found.
+     * @return Coordinate to call.
      */
-    vector<int> PromptUserCoord() const;
+    Coord GetDensityCoord();
 
     /**
-     * Creates random coordinates for the computer.
-     * If the computer is in hardmode, coordinates adjacent to previous hits (not surrounded by previous shots) will be chosen.
-     * @return Coordinate represent as row and column in vector.
+     * Picks the open cell that holds a ship in the most sampled layouts of the opponent's remaining fleet.
+     * Falls back to GetDensityCoord if no layout that fits is found within the budget.
+     * @return Coordinate to call.
      */
-    vector<int> PromptComputerCoord();
+    Coord GetSampledCoord();
 
     /**
-     * Creates a random coordinate within the board.
+     * Checks if the computer picks its shots from density, which then has to follow every shot.
+     * @return Whether or not density is kept up to date.
+     */
+    bool TracksDensity() const;
+
+    /**
+     * Picks the computer's next coordinate in the way of its difficulty. A hard search can pick one that can't be called.
+     * @return Coordinate to call if it is valid.
+     */
+    Coord PickComputerCoord();
+
+    /**
+     * Picks a random coordinate that hasn't been called. There must be one left.
      * @return A random coordinate.
      */
-    vector<int> GetRandCoord() const;
+    Coord GetRandCoord();
 
     /**
      * Checks the possible directions that the coordinate allows.
      * @param coord A coordinate whose sides are being checked.
-     * @return All the valid directions of the search.
+     * @param dirs Receives all the valid directions of the search.
+     * @return Number of valid directions.
      */
-    vector<string> GetPossibleDirs(const vector<int>& coord) const;
+    int GetPossibleDirs(Coord coord, Ship::Direction dirs[]) const;
 
     /**
      * Gets a random direction out of the possible directions.
      * @param sd The search data whose directions are being required.
      * @return A random direction.
      */
-    string GetRandDir(const SearchData sd) const;
+    Ship::Direction GetRandDir(const SearchData& sd);
 
     /**
      * Removes the current direction being used in the search, changing it, and resets the current position to the start.
@@ -245,7 +475,7 @@ private:
      * @param direction Direction of the next coordinate.
      * @return The coordinate at the specified direction.
      */
-    vector<int> GetNext(const vector<int>& coord, string direction) const;
+    Coord GetNext(Coord coord, Ship::Direction direction) const;
 
     /**
      * Picks a random search data's index.
@@ -258,7 +488,7 @@ private:
      * @param coord A coordinate to check.
      * @return A search's index.
      */
-    int GetSearchData(const vector<int>& coord) const;
+    int GetSearchData(Coord coord) const;
 
     /**
      * Assigns the length of a particular ship to a search.
@@ -272,17 +502,35 @@ private:
 
     /**
      * Takes action upon receiving an inputted coordinate.
-     * @param coord Vector of row and column values that is on the board.
+     * @param coord Coordinate that is on the board.
      * @param opponent Opponent of the player.
      * @return The result of the coordinate call.
      */
-    string ShootCoord(const vector<int>& coord, Player& opponent);
+    ShotResult ShootCoord(Coord coord, Player& opponent);
+
+    /**
+     * Displays a battleship board with its name.
+     * @param board The board of a player.
+     * @param info Additional info about the board.
+     * @param showLost Whether or not the number of ships the player has lost will be shown.
+     */
+    void DisplayBoard(const Board& board, string info, bool showLost) const;
+
+    /**
+     * Describes the result of a call for the console.
+     * @param result The resolved call.
+     * @param opponent Opponent of the player.
+     * @return Description of the shot, ending in a newline.
+     */
+    string DescribeShot(const ShotResult& result, Player& opponent) const;
 
     /**
      * Prompts user for orientation of ship.
-     * @return Orientation of ship as string.
+     * @return Orientation of ship.
      */
-    string PromptUserOrientation() const;
+    Ship::Direction PromptUserOrientation() const;
 };
 
+static_assert(is_trivially_copyable<Player::State>::value, "A snapshot must copy as plain memory");
+
 #endif
\ No newline at end of file
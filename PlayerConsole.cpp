@@ -0,0 +1,193 @@
+#include "Player.h"
+#include "Ship.h"
+#include "BoardRenderer.h"
+#include "Instrument.h"
+#include <iostream>
+#include <string>
+#include <cctype>
+using namespace std;
+
+void Player::DisplayBoard(const Board& board, string info, bool showLost) const {
+    string description = name + "'s " + info;
+    string shipsInfoString = "";
+
+    if (!showLost) { // Display # of ships the player has taken instead of ships lost
+        shipsInfoString = "Ships Taken: " + to_string(state.shipsDestroyed);
+    } else {
+        shipsInfoString = "Ships Lost: " + to_string(state.shipsLost);
+    }
+
+    int slot = showLost ? BoardRenderer::SHIPS_SLOT : BoardRenderer::SHOTS_SLOT;
+    BoardRenderer::Get().Draw(slot, board, description, shipsInfoString);
+}
+
+void Player::GenerateShips() {
+    // Let user/computer come up with coordinates and orientations to use.
+    for (int i = 0; i < MAX_SHIPS; i++) {
+        string shipName = SHIP_NAMES[i];
+        int shipLength = SHIP_LENGTHS[i];
+
+        if (!isComputer) {
+            bool valid = false;
+
+            do {
+                cout << "\n< " << shipName << " (" << shipLength << " spaces) >";
+                Coord coord = PromptUserCoord();
+                Ship::Direction orientation = PromptUserOrientation();
+                
+                if (PlaceShip(i, coord, orientation)) {
+                    valid = true;
+                } else {
+                    BATTLESHIP_COUNT(instrument, PLACEMENT_RETRIES);
+                    cout << "Sorry, invalid ship.\n";
+                }
+            } while (!valid);
+            cout << "\nShip set!\n";
+            DisplayBoard(state.shipBoard, "Ships", true);
+        } else { // The computer's fleet is never shown
+            PlaceRandomShip(i);
+        }
+    }
+}
+
+void Player::AnnounceTurn(Player& opponent) {
+    // Output status of both boards, keeping the computer's fleet hidden like it is while it is placed.
+    if (!isComputer) {
+        DisplayBoard(state.shipBoard, "Ships", true);
+    }
+
+    DisplayBoard(state.offensiveBoard, "Shots", false);
+    cout << "\nIt is Captain " << name << "'s turn. You have " << state.numCalls << " call" << ((state.numCalls > 1) ? "s." : ".") << "\n";
+    
+    const Coord* opponentHits = opponent.GetHitsPrev();
+    int prevTimesHit = opponent.GetNumHitsPrev();
+    if (prevTimesHit > 0) {
+        cout << "WARNING: " << opponent.GetName() << " has hit your fleet at";
+        
+        for (int i = 0; i < prevTimesHit; i++) {
+            Coord coord = opponentHits[i];
+            cout << " " << letters[coord.row] << to_string(coord.col + 1);
+            
+            if (prevTimesHit > 1 && i == prevTimesHit - 2) {
+                cout << " and";
+            }
+
+            if (i < prevTimesHit - 2) {
+                cout << ",";
+            }
+        }
+        cout << ".\n";
+        opponent.ResetHitsPrev();
+    } else {
+        cout << "NOTE: " << opponent.GetName() << " has not hit your fleet.\n";
+    }
+}
+
+void Player::AnnounceResults(const ShotResult results[], int numResults, Player& opponent) const {
+    string result = "\n";
+    for (int i = 0; i < numResults; i++) {
+        result += DescribeShot(results[i], opponent);
+    }
+    
+    DisplayBoard(state.offensiveBoard, "Shots", false);
+    cout << result;
+}
+
+string Player::DescribeShot(const ShotResult& result, Player& opponent) const {
+    int row = result.coord.row;
+    int col = result.coord.col;
+    string status = "";
+
+    if (result.shipId != NO_SHIP) {
+        string opponentShipName = opponent.GetShip(result.shipId)->GetName();
+        status += "hit on " + opponentShipName + "!";
+
+        if (result.sunk) {
+            status += "\n" + opponentShipName + " has been sunk!";
+
+            if (result.callsLowered) {
+                status += "\nThe number of coordinates " + opponent.GetName() + " can call has been decreased.";
+            }
+        }
+    } else {
+        status += "miss.";
+    }
+
+    char rowChar;
+    for (int i = 0; i < MAX_SIZE; i++) { // Convert row to char
+        if (row == i) {
+            rowChar = letters[i];
+        }
+    }
+    
+    return rowChar + to_string(col + 1) + " was a " + status + "\n"; // Increase col by one (index is 1 less)
+}
+
+Coord Player::PromptUserCoord() const {
+    Coord coord;
+    bool valid = false;
+    string userStr;
+    cout << "\n";
+    
+    do {
+        cout << "Please enter a valid coordinate (ex: A1): ";
+        getline(cin, userStr);
+        
+        if (userStr.length() >= NUM_DIMENSIONS) {
+            char rowChar = toupper(userStr[0]);
+            int row = 0;
+            bool foundChar = false;
+
+            for (int i = 0; i < MAX_SIZE; i++) {
+                if (letters[i] == rowChar) {
+                    row = i;
+                    foundChar = true;
+                    break;
+                }
+            }
+
+            string colStr = userStr.substr(1);
+            int col = -1; // Out of range until it is parsed
+            bool colIsInt = true;
+
+            for (int i = 0; i < colStr.length(); i++) { // Checks if the rest of the string are numbers
+                if (!isdigit(colStr.at(i))) {
+                    colIsInt = false;
+                }
+            }
+            
+            if (colIsInt) {
+                col = stoi(colStr) - 1; // Convert for easy use with array
+            }
+
+            if (foundChar && colIsInt && col >= 0 && col < MAX_SIZE) { // Check the range before it is packed into a byte
+                coord = Coord(row, col);
+                valid = IsValidCoord(state.offensiveBoard, coord);
+            }
+        }
+
+        if (!valid) {
+            cout << "Sorry, invalid coordinate. ";
+        }
+    } while (!valid);
+    
+    return coord;
+}
+
+Ship::Direction Player::PromptUserOrientation() const {
+    string userOrtn;
+    Ship::Direction orientation;
+    bool foundOrientation = false;
+
+    do {
+        cout << "Please enter a valid ship orientation (ex: NORTH): ";
+        getline(cin, userOrtn);
+        foundOrientation = Ship::ParseDirection(userOrtn, orientation);
+
+        if (!foundOrientation) {
+            cout << "Sorry, invalid orientation. ";
+        }
+    } while (!foundOrientation);
+
+    return orientation;
+}
@@ -0,0 +1,96 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+#include <cstdint>
+using namespace std;
+
+/**
+ * A small, fast pseudo-random number generator (xoshiro256**) that each player and game owns.
+ * The same seed always produces the same sequence, so a game can be replayed from its seed.
+ */
+class Random {
+public:
+    Random();
+    Random(uint64_t seed);
+
+    /**
+     * Restarts the sequence from a seed.
+     * @param seed Any 64-bit value.
+     */
+    void Seed(uint64_t seed);
+
+    /**
+     * Gets the seed the sequence was started from.
+     * @return Seed.
+     */
+    uint64_t GetSeed() const;
+
+    /**
+     * Gets the next random 64-bit value.
+     * @return Random value.
+     */
+    uint64_t Next();
+
+    /**
+     * Gets a random number from 0 up to but not including bound.
+     * @param bound Number of possible values; must be positive.
+     * @return Random number.
+     */
+    int NextInt(int bound);
+private:
+    uint64_t seed;
+    uint64_t state[4];
+
+    /**
+     * Rotates bits left.
+     */
+    static uint64_t Rotl(uint64_t value, int amount);
+};
+
+inline Random::Random() {
+    Seed(0);
+}
+
+inline Random::Random(uint64_t seed) {
+    Seed(seed);
+}
+
+inline void Random::Seed(uint64_t newSeed) {
+    seed = newSeed;
+    uint64_t mix = newSeed;
+
+    for (int i = 0; i < 4; i++) { // Expand the seed with splitmix64 so similar seeds give unrelated states
+        mix += 0x9e3779b97f4a7c15ULL;
+        uint64_t z = mix;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        state[i] = z ^ (z >> 31);
+    }
+}
+
+inline uint64_t Random::GetSeed() const {
+    return seed;
+}
+
+inline uint64_t Random::Rotl(uint64_t value, int amount) {
+    return (value << amount) | (value >> (64 - amount));
+}
+
+inline uint64_t Random::Next() {
+    uint64_t result = Rotl(state[1] * 5, 7) * 9;
+    uint64_t shifted = state[1] << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= shifted;
+    state[3] = Rotl(state[3], 45);
+
+    return result;
+}
+
+inline int Random::NextInt(int bound) {
+    return static_cast<int>(((Next() >> 32) * static_cast<uint64_t>(bound)) >> 32); // Scale instead of using %
+}
+
+#endif
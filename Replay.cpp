@@ -0,0 +1,342 @@
+#include "Replay.h"
+#include "GameEngine.h"
+#include "Player.h"
+#include "Ship.h"
+#include "Coord.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+const char Replay::MAGIC[4] = {'B', 'S', 'R', 'P'};
+
+int Replay::Encode(const GameEngine& game, unsigned char* out) {
+    uint64_t seed = game.GetSeed();
+
+    for (int i = 0; i < 8; i++) {
+        out[i] = static_cast<unsigned char>(seed >> (8 * i));
+    }
+
+    unsigned char flags = 0;
+    unsigned char difficulties = 0;
+
+    for (int i = 0; i < GameEngine::NUM_PLAYERS; i++) {
+        const Player& player = game.GetPlayer(i);
+
+        if (player.IsClassic()) {
+            flags |= CLASSIC_FLAG;
+        }
+
+        if (player.IsComputer()) {
+            flags |= COMPUTER_FLAG << i;
+        }
+
+        difficulties |= player.GetDifficulty() << (DIFFICULTY_BITS * i);
+    }
+
+    int numShots = game.GetNumShots();
+    out[8] = flags;
+    out[9] = difficulties;
+    out[10] = game.GetStartingPlayer();
+    out[11] = game.GetWinner();
+    out[12] = numShots & 0xff;
+    out[13] = numShots >> 8;
+
+    // Fleets, each as the first space of every ship followed by their orientations.
+    unsigned char* fleet = out + 14;
+
+    for (int i = 0; i < GameEngine::NUM_PLAYERS; i++) {
+        const Ship* ships = game.GetPlayer(i).GetShips();
+        int orientations = 0;
+
+        for (int shipId = 0; shipId < Player::MAX_SHIPS; shipId++) {
+            fleet[shipId] = ships[shipId].GetCoords()[0].GetIndex();
+            orientations |= ships[shipId].GetOrientation() << (DIRECTION_BITS * shipId);
+        }
+
+        fleet[Player::MAX_SHIPS] = orientations & 0xff;
+        fleet[Player::MAX_SHIPS + 1] = orientations >> 8;
+        fleet += FLEET_SIZE;
+    }
+
+    for (int i = 0; i < numShots; i++) {
+        out[RECORD_HEADER_SIZE + i] = game.GetShot(i).GetIndex();
+    }
+
+    return RECORD_HEADER_SIZE + numShots;
+}
+
+int Replay::GetRecordSize(const unsigned char* data) {
+    return RECORD_HEADER_SIZE + (data[12] | (data[13] << 8));
+}
+
+bool Replay::Decode(const unsigned char* data, uint64_t size, Record& record) {
+    if (size < RECORD_HEADER_SIZE || size < static_cast<uint64_t>(GetRecordSize(data))) {
+        return false;
+    }
+
+    record.seed = 0;
+
+    for (int i = 0; i < 8; i++) {
+        record.seed |= static_cast<uint64_t>(data[i]) << (8 * i);
+    }
+
+    int flags = data[8];
+    int difficulties = data[9];
+    const int DIFFICULTY_MASK = (1 << DIFFICULTY_BITS) - 1;
+    const int DIRECTION_MASK = (1 << DIRECTION_BITS) - 1;
+    record.isClassic = (flags & CLASSIC_FLAG) != 0;
+    record.startingPlayer = data[10];
+    record.winner = static_cast<signed char>(data[11]);
+    record.numShots = data[12] | (data[13] << 8);
+
+    const unsigned char* fleet = data + 14;
+
+    for (int i = 0; i < GameEngine::NUM_PLAYERS; i++) {
+        record.isComputer[i] = (flags & (COMPUTER_FLAG << i)) != 0;
+        record.difficulty[i] = static_cast<Player::Difficulty>((difficulties >> (DIFFICULTY_BITS * i)) & DIFFICULTY_MASK);
+        int orientations = fleet[Player::MAX_SHIPS] | (fleet[Player::MAX_SHIPS + 1] << 8);
+
+        for (int shipId = 0; shipId < Player::MAX_SHIPS; shipId++) {
+            record.shipCoords[i][shipId] = Coord::FromIndex(fleet[shipId]);
+            record.shipDirections[i][shipId] = static_cast<Ship::Direction>((orientations >> (DIRECTION_BITS * shipId)) &
+                                                                            DIRECTION_MASK);
+        }
+
+        fleet += FLEET_SIZE;
+    }
+
+    record.shots = data + RECORD_HEADER_SIZE;
+    return true;
+}
+
+bool Replay::Verify(const Record& record) {
+    Player first("FIRST PLAYER", record.isComputer[0], record.isClassic, false);
+    Player second("SECOND PLAYER", record.isComputer[1], record.isClassic, false);
+    first.SetDifficulty(record.difficulty[0]);
+    second.SetDifficulty(record.difficulty[1]);
+
+    // The seed decides who starts, so a mismatch means the record doesn't belong to this version of the engine.
+    GameEngine game(first, second, record.seed);
+
+    if (game.GetStartingPlayer() != record.startingPlayer) {
+        return false;
+    }
+
+    for (int i = 0; i < GameEngine::NUM_PLAYERS; i++) {
+        for (int shipId = 0; shipId < Player::MAX_SHIPS; shipId++) {
+            if (!game.GetPlayer(i).PlaceShip(shipId, record.shipCoords[i][shipId], record.shipDirections[i][shipId])) {
+                return false;
+            }
+        }
+    }
+
+    for (int i = 0; i < record.numShots; i++) {
+        if (game.IsOver() || !game.Step(Coord::FromIndex(record.shots[i])).accepted) {
+            return false;
+        }
+    }
+
+    return game.IsOver() && game.GetWinner() == record.winner;
+}
+
+ReplayWriter::ReplayWriter() : buffer(BUFFER_SIZE) {
+    used = 0;
+}
+
+ReplayWriter::~ReplayWriter() {
+    Close();
+}
+
+bool ReplayWriter::Open(const string& path) {
+    Close();
+
+    struct stat info;
+    bool isNew = stat(path.c_str(), &info) != 0 || info.st_size == 0;
+
+    if (!isNew) {
+        // Only append to a log of this version, so records of different layouts never share a file.
+        ReplayReader existing;
+
+        if (!existing.Open(path)) {
+            return false;
+        }
+
+        uint64_t end = existing.GetSize();
+        existing.Close();
+
+        // A run that stopped partway through a write leaves part of a record behind, which would swallow the next game.
+        if (end < static_cast<uint64_t>(info.st_size) && truncate(path.c_str(), end) != 0) {
+            return false;
+        }
+    }
+
+    file.open(path, ios::binary | ios::app);
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    if (isNew) {
+        char header[Replay::FILE_HEADER_SIZE] = {};
+        memcpy(header, Replay::MAGIC, sizeof(Replay::MAGIC));
+        header[sizeof(Replay::MAGIC)] = Replay::VERSION;
+        file.write(header, Replay::FILE_HEADER_SIZE);
+    }
+
+    return file.good();
+}
+
+bool ReplayWriter::IsOpen() const {
+    return file.is_open();
+}
+
+bool ReplayWriter::Write(const GameEngine& game) {
+    if (!file.is_open() || !game.IsOver()) {
+        return false;
+    }
+
+    if (used + Replay::MAX_RECORD_SIZE > BUFFER_SIZE && !Flush()) {
+        return false;
+    }
+
+    used += Replay::Encode(game, buffer.data() + used);
+    return true;
+}
+
+bool ReplayWriter::Flush() {
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(buffer.data()), used);
+    file.flush();
+    used = 0;
+    return file.good();
+}
+
+void ReplayWriter::Close() {
+    if (file.is_open()) {
+        Flush();
+        file.close();
+    }
+}
+
+ReplayReader::ReplayReader() {
+    data = nullptr;
+    size = 0;
+    mappedSize = 0;
+    numGames = 0;
+}
+
+ReplayReader::~ReplayReader() {
+    Close();
+}
+
+bool ReplayReader::Open(const string& path) {
+    Close();
+
+    int fd = open(path.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+
+    if (fstat(fd, &info) != 0 || info.st_size < Replay::FILE_HEADER_SIZE) {
+        close(fd);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps the file open
+
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+
+    data = static_cast<const unsigned char*>(mapped);
+    mappedSize = info.st_size;
+
+    if (memcmp(data, Replay::MAGIC, sizeof(Replay::MAGIC)) != 0 || data[sizeof(Replay::MAGIC)] != Replay::VERSION) {
+        Close();
+        return false;
+    }
+
+    // Hop from header to header to count the games and index every INDEX_INTERVAL-th one.
+    madvise(mapped, mappedSize, MADV_SEQUENTIAL);
+    uint64_t offset = Replay::FILE_HEADER_SIZE;
+
+    while (mappedSize - offset >= static_cast<uint64_t>(Replay::RECORD_HEADER_SIZE)) {
+        uint64_t recordSize = Replay::GetRecordSize(data + offset);
+
+        if (mappedSize - offset < recordSize) {
+            break;
+        }
+
+        if (numGames % INDEX_INTERVAL == 0) {
+            index.push_back(offset);
+        }
+
+        offset += recordSize;
+        numGames++;
+    }
+
+    size = offset;
+    madvise(mapped, mappedSize, MADV_NORMAL);
+    return true;
+}
+
+void ReplayReader::Close() {
+    if (data != nullptr) {
+        munmap(const_cast<unsigned char*>(data), mappedSize);
+    }
+
+    data = nullptr;
+    size = 0;
+    mappedSize = 0;
+    numGames = 0;
+    index.clear();
+}
+
+long long ReplayReader::GetNumGames() const {
+    return numGames;
+}
+
+uint64_t ReplayReader::GetSize() const {
+    return size;
+}
+
+bool ReplayReader::GetGame(long long gameNum, Replay::Record& record) const {
+    if (gameNum < 0 || gameNum >= numGames) {
+        return false;
+    }
+
+    uint64_t offset = index[gameNum / INDEX_INTERVAL];
+
+    for (long long i = 0; i < gameNum % INDEX_INTERVAL; i++) {
+        offset += Replay::GetRecordSize(data + offset);
+    }
+
+    return Next(offset, record);
+}
+
+uint64_t ReplayReader::Begin() const {
+    return Replay::FILE_HEADER_SIZE;
+}
+
+bool ReplayReader::Next(uint64_t& offset, Replay::Record& record) const {
+    if (offset >= size || !Replay::Decode(data + offset, size - offset, record)) {
+        return false;
+    }
+
+    offset += Replay::GetRecordSize(data + offset);
+    return true;
+}
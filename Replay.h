@@ -0,0 +1,207 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+#include "GameEngine.h"
+#include "Player.h"
+#include "Ship.h"
+#include "Coord.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * Layout of the binary replay log. Multi-byte fields are little-endian.
+ * A file starts with FILE_HEADER_SIZE bytes (MAGIC, then VERSION, then zeros) and is followed by one record per game:
+ *   0  seed of the game (8 bytes)
+ *   8  flags: CLASSIC_FLAG, and COMPUTER_FLAG shifted by the player's index
+ *   9  difficulty of each player, DIFFICULTY_BITS per player starting from the first
+ *  10  starting player
+ *  11  winner
+ *  12  number of shots (2 bytes)
+ *  14  fleet of each player: the bit index of every ship's first space (1 byte each), then the orientations of the
+ *      ships, DIRECTION_BITS per ship starting from the first (2 bytes)
+ *  28  bit index of every coordinate accepted by GameEngine::Step, in order (1 byte each)
+ */
+class Replay {
+public:
+    static const char MAGIC[4];
+    static const unsigned char VERSION = 1;
+    static const int FILE_HEADER_SIZE = 8;
+
+    static const int CLASSIC_FLAG = 1;
+    static const int COMPUTER_FLAG = 2;
+    static const int DIFFICULTY_BITS = 2;
+    static const int DIRECTION_BITS = 2;
+
+    static const int FLEET_SIZE = Player::MAX_SHIPS + 2;
+    static const int RECORD_HEADER_SIZE = 14 + GameEngine::NUM_PLAYERS * FLEET_SIZE;
+    static const int MAX_RECORD_SIZE = RECORD_HEADER_SIZE + GameEngine::MAX_SHOTS;
+
+    /**
+     * One game unpacked from a record. The shots still point into the record, so no copy of them is made.
+     */
+    struct Record {
+        uint64_t seed;
+        bool isClassic;
+        bool isComputer[GameEngine::NUM_PLAYERS];
+        Player::Difficulty difficulty[GameEngine::NUM_PLAYERS];
+        int startingPlayer;
+        int winner;
+        int numShots;
+        Coord shipCoords[GameEngine::NUM_PLAYERS][Player::MAX_SHIPS]; // First space of every ship
+        Ship::Direction shipDirections[GameEngine::NUM_PLAYERS][Player::MAX_SHIPS];
+        const unsigned char* shots; // Bit index of every call, in order
+    };
+
+    /**
+     * Packs a finished game into a record.
+     * @param game A game whose players have placed all their ships.
+     * @param out Receives the record; must have room for MAX_RECORD_SIZE bytes.
+     * @return Size of the record in bytes.
+     */
+    static int Encode(const GameEngine& game, unsigned char* out);
+
+    /**
+     * Gets the size of a record from its header.
+     * @param data Start of the record; must have RECORD_HEADER_SIZE bytes.
+     * @return Size of the record in bytes.
+     */
+    static int GetRecordSize(const unsigned char* data);
+
+    /**
+     * Unpacks a record.
+     * @param data Start of the record.
+     * @param size Bytes available from data onward.
+     * @param record Receives the game.
+     * @return Whether or not a whole record was there.
+     */
+    static bool Decode(const unsigned char* data, uint64_t size, Record& record);
+
+    /**
+     * Plays a recorded game again through GameEngine::Step, placing the recorded fleets and calling the recorded shots.
+     * @param record The game.
+     * @return Whether or not every call was accepted and the game ended on the last one with the recorded winner.
+     */
+    static bool Verify(const Record& record);
+};
+
+/**
+ * Appends games to a replay log, collecting records in memory and writing them out a buffer at a time.
+ */
+class ReplayWriter {
+public:
+    static const int BUFFER_SIZE = 1 << 20; // Several thousand games per write
+
+    ReplayWriter();
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+    ~ReplayWriter();
+
+    /**
+     * Opens a log to append to. A missing or empty file is started with the file header. A record cut short at the end
+     * of an existing log (a write that never finished) is cut off first, so new games follow the last whole one.
+     * @param path Path of the log.
+     * @return Whether or not the file could be opened, is a log of this version if it isn't empty, and could be cut back
+     *         to its last whole game.
+     */
+    bool Open(const string& path);
+
+    /**
+     * Checks if a log is open.
+     * @return Whether or not games can be written.
+     */
+    bool IsOpen() const;
+
+    /**
+     * Adds a game to the log. It reaches the file when the buffer fills up, on Flush, or on Close.
+     * @param game A game that is over.
+     * @return Whether or not the game was recorded.
+     */
+    bool Write(const GameEngine& game);
+
+    /**
+     * Writes out every buffered game.
+     * @return Whether or not the write succeeded.
+     */
+    bool Flush();
+
+    /**
+     * Flushes and closes the log.
+     */
+    void Close();
+private:
+    ofstream file;
+    vector<unsigned char> buffer;
+    int used; // Bytes of buffer holding records that have not been written
+};
+
+/**
+ * Reads a replay log by mapping it into memory, so games are read in place without copying the file.
+ * Every INDEX_INTERVAL-th game is indexed when the log is opened, so any game can be found by skipping at most
+ * INDEX_INTERVAL - 1 records.
+ */
+class ReplayReader {
+public:
+    static const int INDEX_INTERVAL = 1024;
+
+    ReplayReader();
+    ReplayReader(const ReplayReader&) = delete;
+    ReplayReader& operator=(const ReplayReader&) = delete;
+    ~ReplayReader();
+
+    /**
+     * Maps a log and indexes its games. A record cut short at the end of the file (a write that never finished) is
+     * left out.
+     * @param path Path of the log.
+     * @return Whether or not the file could be mapped and is a log of this version.
+     */
+    bool Open(const string& path);
+
+    /**
+     * Unmaps the log.
+     */
+    void Close();
+
+    /**
+     * Gets the number of whole games in the log.
+     * @return Number of games.
+     */
+    long long GetNumGames() const;
+
+    /**
+     * Gets the size of the log up to the end of its last whole game.
+     * @return Size in bytes, including the file header.
+     */
+    uint64_t GetSize() const;
+
+    /**
+     * Gets a game by its position in the log.
+     * @param gameNum Index of the game, from 0 for the first.
+     * @param record Receives the game.
+     * @return Whether or not the game exists.
+     */
+    bool GetGame(long long gameNum, Replay::Record& record) const;
+
+    /**
+     * Gets the offset of the first game, to start iterating with Next.
+     * @return Offset in bytes.
+     */
+    uint64_t Begin() const;
+
+    /**
+     * Reads the game at an offset and moves the offset to the game after it.
+     * @param offset Offset of the game; start from Begin().
+     * @param record Receives the game.
+     * @return Whether or not there was a game at the offset.
+     */
+    bool Next(uint64_t& offset, Replay::Record& record) const;
+private:
+    const unsigned char* data;
+    uint64_t size; // Bytes of whole records, including the file header
+    uint64_t mappedSize;
+    long long numGames;
+    vector<uint64_t> index; // Offset of every INDEX_INTERVAL-th game
+};
+
+#endif
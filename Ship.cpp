@@ -1,21 +1,46 @@
 #include "Ship.h"
+#include <cctype>
 using namespace std;
 
-const string Ship::NORTH = "NORTH";
-const string Ship::EAST = "EAST";
-const string Ship::SOUTH = "SOUTH";
-const string Ship::WEST = "WEST";
-const vector<string> Ship::ORIENTATIONS = {NORTH, EAST, SOUTH, WEST};
+const string Ship::DIRECTION_NAMES[NUM_DIRECTIONS] = {"NORTH", "EAST", "SOUTH", "WEST"};
+const int Ship::ROW_DELTAS[NUM_DIRECTIONS] = {-1, 0, 1, 0};
+const int Ship::COL_DELTAS[NUM_DIRECTIONS] = {0, 1, 0, -1};
 
 Ship::Ship() {
     name = "";
     length = 0;
+    hp = 0;
+    hitMask = 0;
     orientation = NORTH;
+    numCoords = 0;
 }
 
-Ship::Ship(string shipName, int shipLength) {
+Ship::Ship(const char* shipName, int shipLength) {
     name = shipName;
     length = shipLength;
+    hp = shipLength;
+    hitMask = 0;
+    orientation = NORTH;
+    numCoords = 0;
+}
+
+Ship::Direction Ship::GetOpposite(Direction direction) {
+    return static_cast<Direction>((direction + NUM_DIRECTIONS / 2) % NUM_DIRECTIONS);
+}
+
+bool Ship::ParseDirection(string text, Direction& direction) {
+    for (size_t i = 0; i < text.length(); i++) { // toupper() string
+        text[i] = toupper(text[i]);
+    }
+
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        if (text == DIRECTION_NAMES[i]) {
+            direction = static_cast<Direction>(i);
+            return true;
+        }
+    }
+
+    return false;
 }
 
 string Ship::GetName() const {
@@ -26,49 +51,54 @@ int Ship::GetLength() const {
     return length;
 }
 
-string Ship::GetOrientation() const {
+Ship::Direction Ship::GetOrientation() const {
     return orientation;
 }
 
-void Ship::SetOrientation(string shipOrientation) {
+void Ship::SetOrientation(Direction shipOrientation) {
     orientation = shipOrientation;
 }
 
-void Ship::SetCoord(const vector<int>& coord) {
-    coordsList.push_back(coord);
+void Ship::SetCoord(Coord coord) {
+    if (numCoords < MAX_LENGTH) {
+        coordsList[numCoords] = coord;
+        numCoords++;
+    }
 }
     
-void Ship::SetHitCoord(const vector<int>& coord) {
-    hitCoords.push_back(coord);
+void Ship::SetHitCoord(Coord coord) {
+    for (int i = 0; i < numCoords; i++) { // Find which space of the ship was hit
+        unsigned int bit = 1u << i;
+
+        if (coordsList[i] == coord && (hitMask & bit) == 0) {
+            hitMask |= bit;
+            hitCoords[length - hp] = coord;
+            hp--;
+            break;
+        }
+    }
 }
 
-vector<vector<int>> Ship::GetHitCoords() const {
+const Coord* Ship::GetHitCoords() const {
     return hitCoords;
 }
 
-bool Ship::IsShipSunk() const {
-    int equalCount = 0;
-    
-    for (int i = 0; i < hitCoords.size(); i++) {
-        vector<int> hitCoord = hitCoords[i];
-
-        for (int j = 0; j < coordsList.size(); j++) { // Compare the coordinate against all ship coordinates
-            vector<int> shipCoord = coordsList[j];
-            
-            if (hitCoord == shipCoord) {
-                equalCount++;
-                break;
-            }
-        }
-    }
+int Ship::GetNumHitCoords() const {
+    return length - hp;
+}
 
-    if (equalCount == length) {
-        return true;
-    } else {
-        return false;
-    }
+int Ship::GetHP() const {
+    return hp;
+}
+
+bool Ship::IsShipSunk() const {
+    return hp == 0;
 }
 
-vector<vector<int>> Ship::GetCoords() const {
+const Coord* Ship::GetCoords() const {
     return coordsList;
+}
+
+int Ship::GetNumCoords() const {
+    return numCoords;
 }
\ No newline at end of file
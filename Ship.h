@@ -1,7 +1,8 @@
 #ifndef SHIP_H
 #define SHIP_H
+#include "Coord.h"
 #include <string>
-#include <vector>
+#include <type_traits>
 using namespace std;
 
 class Ship {
@@ -11,14 +12,40 @@ public:
     static const int CRUISER_HP = 3;
     static const int BATTLESHIP_HP = 4;
     static const int CARRIER_HP = 5;
-    static const string NORTH;
-    static const string EAST;
-    static const string SOUTH;
-    static const string WEST;
-    static const vector<string> ORIENTATIONS;
+    static const int MAX_LENGTH = CARRIER_HP;
+
+    /**
+     * Which way a ship runs from its first coordinate, or which way a search moves from a hit.
+     */
+    enum Direction {
+        NORTH,
+        EAST,
+        SOUTH,
+        WEST
+    };
+
+    static const int NUM_DIRECTIONS = 4;
+    static const string DIRECTION_NAMES[NUM_DIRECTIONS]; // Only for display and parsing
+    static const int ROW_DELTAS[NUM_DIRECTIONS]; // Change in row for one step in each direction
+    static const int COL_DELTAS[NUM_DIRECTIONS]; // Change in column for one step in each direction
 
     Ship();
-    Ship(string shipName, int shipLength);
+    Ship(const char* shipName, int shipLength);
+
+    /**
+     * Gets the direction pointing the other way.
+     * @param direction A direction.
+     * @return The opposite direction.
+     */
+    static Direction GetOpposite(Direction direction);
+
+    /**
+     * Reads a direction from its name, ignoring case.
+     * @param text Text to read.
+     * @param direction Receives the direction if the text names one.
+     * @return Whether or not the text named a direction.
+     */
+    static bool ParseDirection(string text, Direction& direction);
 
     /**
      * Gets name of ship.
@@ -36,53 +63,70 @@ public:
      * Gets orientation of ship.
      * @return Ship orientation.
      */
-    string GetOrientation() const;
+    Direction GetOrientation() const;
 
     /**
      * Sets orientation of ship.
      * @param orientation Orientation of ship.
      */
-    void SetOrientation(string shipOrientation);
+    void SetOrientation(Direction shipOrientation);
 
     /**
-     * Adds coordinate to let a ship occupy space on the board.
-     * @param coord Coordinate of ship in vector of row, col.
+     * Adds coordinate to let a ship occupy space on the board. A ship holds at most MAX_LENGTH coordinates.
+     * @param coord Coordinate of ship.
      */
-    void SetCoord(const vector<int>& coord);
+    void SetCoord(Coord coord);
 
     /**
-     * Sets a coordinate to hit.
+     * Sets a coordinate to hit. Hitting the same coordinate twice only counts once.
      * @param coord Coordinate to hit.
      */
-    void SetHitCoord(const vector<int>& coord);
+    void SetHitCoord(Coord coord);
+
+    /**
+     * Gets all hit coordinates in the order they were hit.
+     * @return The first of GetNumHitCoords() hit coordinates.
+     */
+    const Coord* GetHitCoords() const;
+
+    /**
+     * Gets the number of spaces of the ship that have been hit.
+     * @return Number of hit coordinates.
+     */
+    int GetNumHitCoords() const;
 
     /**
-     * Gets all hit coordinates.
-     * @return Vector of a vector<int> representing all hit coordinates.
+     * Gets the number of spaces of the ship that have not been hit.
+     * @return Remaining HP.
      */
-    vector<vector<int>> GetHitCoords() const;
+    int GetHP() const;
 
     /**
-     * Checks if the ship is sunk by comparing hitCoords to coordsList.
+     * Checks if the ship is sunk (no HP left).
      */
     bool IsShipSunk() const;
 
     /**
      * Get all the coordinates of the ship.
-     * @return Vector of row, col values all in one vector.
+     * @return The first of GetNumCoords() coordinates, from the first one placed to the last.
      */
-    vector<vector<int>> GetCoords() const;
-private:
-    string name;
-    int length;
-    string orientation;
-    vector<string> orientations;
-    vector<vector<int>> coordsList;
-    vector<vector<int>> hitCoords;
-    
+    const Coord* GetCoords() const;
+
     /**
-     * Makes all possible orientations as elements of orientations.
+     * Gets the number of coordinates the ship has been given.
+     * @return Number of coordinates.
      */
-    void MakeOrientations();
+    int GetNumCoords() const;
+private:
+    const char* name; // Points at a string literal, so ships copy as plain bytes
+    int length;
+    int hp;
+    unsigned int hitMask; // Bit i is set once coordsList[i] has been hit
+    Direction orientation;
+    int numCoords;
+    Coord coordsList[MAX_LENGTH];
+    Coord hitCoords[MAX_LENGTH]; // The first length - hp entries are used
 };
+
+static_assert(is_trivially_copyable<Ship>::value, "A fleet must copy and reset as plain memory");
 #endif
\ No newline at end of file
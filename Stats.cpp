@@ -0,0 +1,312 @@
+#include "Stats.h"
+#include "GameEngine.h"
+#include "Player.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+using namespace std;
+
+const string Stats::KIND_NAMES[NUM_KINDS] = {"USER", "EASY COMPUTER", "HARD COMPUTER", "EXPERT COMPUTER",
+                                             "MONTE CARLO COMPUTER"};
+const string Stats::MODE_NAMES[NUM_MODES] = {"CLASSIC", "SALVO"};
+
+bool Stats::Totals::operator==(const Totals& other) const {
+    if (games != other.games || wins != other.wins || hits != other.hits || calls != other.calls ||
+        accuracySum != other.accuracySum) {
+        return false;
+    }
+
+    for (int turns = 0; turns <= MAX_TURNS; turns++) {
+        if (turnHistogram[turns] != other.turnHistogram[turns]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int Stats::GetKind(const Player& player) {
+    return player.IsComputer() ? KIND_USER + 1 + player.GetDifficulty() : KIND_USER;
+}
+
+int Stats::GetMode(const Player& player) {
+    return player.IsClassic() ? MODE_CLASSIC : MODE_SALVO;
+}
+
+StatsAccumulator::StatsAccumulator() {
+    for (int kind = 0; kind < Stats::NUM_KINDS; kind++) {
+        for (int mode = 0; mode < Stats::NUM_MODES; mode++) {
+            Counters& c = counters[kind][mode];
+            c.games.store(0, memory_order_relaxed);
+            c.wins.store(0, memory_order_relaxed);
+            c.hits.store(0, memory_order_relaxed);
+            c.calls.store(0, memory_order_relaxed);
+            c.accuracySum.store(0, memory_order_relaxed);
+
+            for (int turns = 0; turns <= Stats::MAX_TURNS; turns++) {
+                c.turnHistogram[turns].store(0, memory_order_relaxed);
+            }
+        }
+    }
+}
+
+template <typename T>
+void StatsAccumulator::Add(atomic<T>& counter, T amount) {
+    counter.store(counter.load(memory_order_relaxed) + amount, memory_order_relaxed);
+}
+
+void StatsAccumulator::Record(const GameEngine& game) {
+    for (int i = 0; i < GameEngine::NUM_PLAYERS; i++) {
+        const Player& player = game.GetPlayer(i);
+        Counters& c = counters[Stats::GetKind(player)][Stats::GetMode(player)];
+        Add(c.hits, static_cast<long long>(player.GetHitCount()));
+        Add(c.calls, static_cast<long long>(player.GetCallCount()));
+        Add(c.accuracySum, player.GetAccuracy());
+
+        if (game.GetWinner() == i) {
+            int turns = (game.GetTurnCount() + 1) / 2; // The winner took the last turn, so they took the extra one if any
+            Add(c.wins, 1LL);
+            Add(c.turnHistogram[(turns < Stats::MAX_TURNS) ? turns : Stats::MAX_TURNS], 1LL);
+        }
+
+        // Publishes the game: a reader that sees the new count also sees every counter above.
+        c.games.store(c.games.load(memory_order_relaxed) + 1, memory_order_release);
+    }
+}
+
+void StatsAccumulator::AddTo(Stats::Totals totals[Stats::NUM_KINDS][Stats::NUM_MODES]) const {
+    for (int kind = 0; kind < Stats::NUM_KINDS; kind++) {
+        for (int mode = 0; mode < Stats::NUM_MODES; mode++) {
+            const Counters& c = counters[kind][mode];
+            Stats::Totals& t = totals[kind][mode];
+            t.games += c.games.load(memory_order_acquire); // First, so every game it counts is whole below
+            t.wins += c.wins.load(memory_order_relaxed);
+            t.hits += c.hits.load(memory_order_relaxed);
+            t.calls += c.calls.load(memory_order_relaxed);
+            t.accuracySum += c.accuracySum.load(memory_order_relaxed);
+
+            for (int turns = 0; turns <= Stats::MAX_TURNS; turns++) {
+                t.turnHistogram[turns] += c.turnHistogram[turns].load(memory_order_relaxed);
+            }
+        }
+    }
+}
+
+StatsAggregator::StatsAggregator(const string& path, Format format) {
+    this->path = path;
+    this->format = format;
+    stopFlusher = false;
+
+    if (format == CSV) {
+        LoadCsv();
+    }
+
+    for (int kind = 0; kind < Stats::NUM_KINDS; kind++) {
+        for (int mode = 0; mode < Stats::NUM_MODES; mode++) {
+            flushed[kind][mode] = loaded[kind][mode];
+        }
+    }
+}
+
+StatsAggregator::~StatsAggregator() {
+    StopAutoFlush();
+}
+
+StatsAccumulator& StatsAggregator::AddAccumulator() {
+    lock_guard<mutex> guard(lock);
+    accumulators.emplace_back();
+    return accumulators.back();
+}
+
+bool StatsAggregator::Flush() {
+    lock_guard<mutex> guard(lock);
+    Stats::Totals totals[Stats::NUM_KINDS][Stats::NUM_MODES];
+
+    for (int kind = 0; kind < Stats::NUM_KINDS; kind++) {
+        for (int mode = 0; mode < Stats::NUM_MODES; mode++) {
+            totals[kind][mode] = loaded[kind][mode];
+        }
+    }
+
+    for (const StatsAccumulator& accumulator : accumulators) {
+        accumulator.AddTo(totals);
+    }
+
+    bool written = (format == CSV) ? WriteCsv(totals) : AppendJsonl(totals);
+
+    for (int kind = 0; kind < Stats::NUM_KINDS; kind++) {
+        for (int mode = 0; mode < Stats::NUM_MODES; mode++) {
+            flushed[kind][mode] = totals[kind][mode];
+        }
+    }
+
+    return written;
+}
+
+void StatsAggregator::StartAutoFlush(int milliseconds) {
+    StopAutoFlush();
+    stopFlusher = false;
+
+    flusher = thread([this, milliseconds]() {
+        unique_lock<mutex> wait(flusherLock);
+
+        while (!flusherWake.wait_for(wait, chrono::milliseconds(milliseconds), [this]() { return stopFlusher; })) {
+            Flush();
+        }
+    });
+}
+
+void StatsAggregator::StopAutoFlush() {
+    if (flusher.joinable()) {
+        {
+            lock_guard<mutex> guard(flusherLock);
+            stopFlusher = true;
+        }
+
+        flusherWake.notify_one();
+        flusher.join();
+    }
+
+    Flush();
+}
+
+Stats::Totals StatsAggregator::GetTotals(int kind, int mode) const {
+    lock_guard<mutex> guard(lock);
+    return flushed[kind][mode];
+}
+
+void StatsAggregator::LoadCsv() {
+    ifstream file(path);
+    string line;
+    getline(file, line); // Column names
+
+    while (getline(file, line)) {
+        istringstream row(line);
+        string kindName;
+        string modeName;
+        string field;
+        getline(row, kindName, ',');
+        getline(row, modeName, ',');
+
+        int kind = 0;
+        int mode = 0;
+
+        while (kind < Stats::NUM_KINDS && Stats::KIND_NAMES[kind] != kindName) {
+            kind++;
+        }
+
+        while (mode < Stats::NUM_MODES && Stats::MODE_NAMES[mode] != modeName) {
+            mode++;
+        }
+
+        if (kind == Stats::NUM_KINDS || mode == Stats::NUM_MODES) {
+            continue;
+        }
+
+        // games,wins,hits,calls,accuracy_sum,mean_accuracy,turns_to_win
+        Stats::Totals& t = loaded[kind][mode];
+        char comma;
+        double meanAccuracy;
+        row >> t.games >> comma >> t.wins >> comma >> t.hits >> comma >> t.calls >> comma >> t.accuracySum >> comma
+            >> meanAccuracy >> comma;
+
+        int turns;
+        long long count;
+
+        while (row >> turns >> comma >> count) { // Pairs of turns:count
+            if (turns >= 0 && turns <= Stats::MAX_TURNS) {
+                t.turnHistogram[turns] = count;
+            }
+        }
+    }
+}
+
+bool StatsAggregator::WriteCsv(const Stats::Totals totals[Stats::NUM_KINDS][Stats::NUM_MODES]) const {
+    const int PRECISION = 4;
+
+    // Write a new file and move it over the old one, so a reader never sees half of it.
+    string tempPath = path + ".tmp";
+    ofstream file(tempPath);
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << fixed << setprecision(PRECISION);
+    file << "kind,mode,games,wins,hits,calls,accuracy_sum,mean_accuracy,turns_to_win\n";
+
+    for (int kind = 0; kind < Stats::NUM_KINDS; kind++) {
+        for (int mode = 0; mode < Stats::NUM_MODES; mode++) {
+            const Stats::Totals& t = totals[kind][mode];
+
+            if (t.games == 0) {
+                continue;
+            }
+
+            file << Stats::KIND_NAMES[kind] << "," << Stats::MODE_NAMES[mode] << "," << t.games << "," << t.wins << ","
+                 << t.hits << "," << t.calls << "," << t.accuracySum << "," << t.accuracySum / t.games << ",";
+
+            for (int turns = 0; turns <= Stats::MAX_TURNS; turns++) {
+                if (t.turnHistogram[turns] > 0) {
+                    file << " " << turns << ":" << t.turnHistogram[turns];
+                }
+            }
+
+            file << "\n";
+        }
+    }
+
+    file.close();
+    return !file.fail() && rename(tempPath.c_str(), path.c_str()) == 0;
+}
+
+bool StatsAggregator::AppendJsonl(const Stats::Totals totals[Stats::NUM_KINDS][Stats::NUM_MODES]) const {
+    const int PRECISION = 4;
+
+    ostringstream lines;
+    lines << fixed << setprecision(PRECISION);
+
+    for (int kind = 0; kind < Stats::NUM_KINDS; kind++) {
+        for (int mode = 0; mode < Stats::NUM_MODES; mode++) {
+            const Stats::Totals& t = totals[kind][mode];
+            const Stats::Totals& last = flushed[kind][mode];
+
+            if (t == last) { // Only a row with no change at all is left out
+                continue;
+            }
+
+            lines << "{\"kind\":\"" << Stats::KIND_NAMES[kind] << "\",\"mode\":\"" << Stats::MODE_NAMES[mode]
+                  << "\",\"games\":" << t.games - last.games << ",\"wins\":" << t.wins - last.wins
+                  << ",\"hits\":" << t.hits - last.hits << ",\"calls\":" << t.calls - last.calls
+                  << ",\"accuracy_sum\":" << t.accuracySum - last.accuracySum << ",\"turns_to_win\":{";
+            bool first = true;
+
+            for (int turns = 0; turns <= Stats::MAX_TURNS; turns++) {
+                long long count = t.turnHistogram[turns] - last.turnHistogram[turns];
+
+                if (count > 0) {
+                    lines << (first ? "" : ",") << "\"" << turns << "\":" << count;
+                    first = false;
+                }
+            }
+
+            lines << "}}\n";
+        }
+    }
+
+    string text = lines.str();
+
+    if (text.empty()) {
+        return true;
+    }
+
+    ofstream file(path, ios::app);
+    file << text;
+    return file.good();
+}
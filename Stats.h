@@ -0,0 +1,193 @@
+#ifndef STATS_H
+#define STATS_H
+#include "GameEngine.h"
+#include "Player.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+using namespace std;
+
+/**
+ * Running totals of finished games, kept for every kind of player (the user or a computer difficulty) in each mode.
+ */
+class Stats {
+public:
+    static const int NUM_KINDS = 5; // KIND_USER, then one per Player::Difficulty
+    static const int KIND_USER = 0;
+    static const int NUM_MODES = 2;
+    static const int MODE_CLASSIC = 0;
+    static const int MODE_SALVO = 1;
+    static const int MAX_TURNS = Player::MAX_SIZE * Player::MAX_SIZE; // A player can't take more turns than there are cells
+
+    static const string KIND_NAMES[NUM_KINDS];
+    static const string MODE_NAMES[NUM_MODES];
+
+    /**
+     * Totals for one kind of player in one mode.
+     */
+    struct Totals {
+        long long games = 0;
+        long long wins = 0;
+        long long hits = 0;
+        long long calls = 0;
+        double accuracySum = 0; // Sum of Player::GetAccuracy over the games, in percent
+        long long turnHistogram[MAX_TURNS + 1] = {}; // Turns taken in the games won, indexed by turn count
+
+        bool operator==(const Totals& other) const;
+    };
+
+    /**
+     * Finds which row of the totals a player belongs to.
+     * @param player A player.
+     * @return Kind of the player.
+     */
+    static int GetKind(const Player& player);
+
+    /**
+     * Finds which column of the totals a player belongs to.
+     * @param player A player.
+     * @return Mode the player is playing.
+     */
+    static int GetMode(const Player& player);
+};
+
+/**
+ * Totals gathered by one thread. Only the owning thread records into it, so each counter is bumped with a plain
+ * relaxed load and store instead of a locked add, and a StatsAggregator can read it at any time without stopping it.
+ * The games counter is bumped last with release ordering and read first with acquire ordering, so a reader never sees
+ * a game counted without everything else it recorded.
+ */
+class StatsAccumulator {
+public:
+    StatsAccumulator();
+    StatsAccumulator(const StatsAccumulator&) = delete;
+    StatsAccumulator& operator=(const StatsAccumulator&) = delete;
+
+    /**
+     * Adds a finished game for both of its players.
+     * @param game A game that is over.
+     */
+    void Record(const GameEngine& game);
+
+    /**
+     * Adds what has been recorded so far into totals.
+     * @param totals Totals indexed by kind and mode.
+     */
+    void AddTo(Stats::Totals totals[Stats::NUM_KINDS][Stats::NUM_MODES]) const;
+private:
+    struct Counters {
+        atomic<long long> games;
+        atomic<long long> wins;
+        atomic<long long> hits;
+        atomic<long long> calls;
+        atomic<double> accuracySum;
+        atomic<long long> turnHistogram[Stats::MAX_TURNS + 1];
+    };
+    Counters counters[Stats::NUM_KINDS][Stats::NUM_MODES];
+
+    /**
+     * Adds to a counter that only this accumulator's thread writes.
+     * @param counter The counter.
+     * @param amount Amount to add.
+     */
+    template <typename T>
+    static void Add(atomic<T>& counter, T amount);
+};
+
+/**
+ * Merges the accumulators of every thread and writes the totals to a file, on demand or on a timer.
+ * A CSV file holds the totals themselves: it is read back when the aggregator starts, so the totals carry on across
+ * runs, and rewritten on every flush. A JSONL file gets one line per kind and mode that changed since the last flush,
+ * holding only the change, so the lines of the file add up to the totals.
+ */
+class StatsAggregator {
+public:
+    /**
+     * Format of the output file.
+     */
+    enum Format {
+        CSV,
+        JSONL
+    };
+
+    /**
+     * Starts aggregating into a file. A CSV file's existing totals are loaded.
+     * @param path Path of the output file.
+     * @param format Format of the output file.
+     */
+    StatsAggregator(const string& path, Format format);
+    StatsAggregator(const StatsAggregator&) = delete;
+    StatsAggregator& operator=(const StatsAggregator&) = delete;
+
+    /**
+     * Stops any timer and flushes one last time.
+     */
+    ~StatsAggregator();
+
+    /**
+     * Makes an accumulator for one thread to record games into. It lives as long as the aggregator.
+     * @return The accumulator.
+     */
+    StatsAccumulator& AddAccumulator();
+
+    /**
+     * Merges every accumulator and writes the totals out.
+     * @return Whether or not the file could be written.
+     */
+    bool Flush();
+
+    /**
+     * Flushes in the background every so often until StopAutoFlush.
+     * @param milliseconds Time between flushes.
+     */
+    void StartAutoFlush(int milliseconds);
+
+    /**
+     * Stops flushing in the background, then flushes once more.
+     */
+    void StopAutoFlush();
+
+    /**
+     * Gets the totals as of the last flush, including any loaded from the file.
+     * @param kind Kind of player.
+     * @param mode Mode.
+     * @return The totals.
+     */
+    Stats::Totals GetTotals(int kind, int mode) const;
+private:
+    string path;
+    Format format;
+    deque<StatsAccumulator> accumulators; // A deque never moves its elements, so accumulators can be handed out
+    Stats::Totals loaded[Stats::NUM_KINDS][Stats::NUM_MODES]; // Totals read from the file at the start
+    Stats::Totals flushed[Stats::NUM_KINDS][Stats::NUM_MODES]; // Totals as of the last flush
+    mutable mutex lock; // Guards accumulators being added, flushed, and flushes from more than one thread
+
+    thread flusher;
+    mutex flusherLock;
+    condition_variable flusherWake;
+    bool stopFlusher;
+
+    /**
+     * Reads the totals of an existing CSV file into loaded.
+     */
+    void LoadCsv();
+
+    /**
+     * Rewrites the CSV file with the totals.
+     * @param totals Totals to write.
+     * @return Whether or not the file could be written.
+     */
+    bool WriteCsv(const Stats::Totals totals[Stats::NUM_KINDS][Stats::NUM_MODES]) const;
+
+    /**
+     * Appends the changes since the last flush to the JSONL file.
+     * @param totals Totals to write.
+     * @return Whether or not the file could be written.
+     */
+    bool AppendJsonl(const Stats::Totals totals[Stats::NUM_KINDS][Stats::NUM_MODES]) const;
+};
+
+#endif
@@ -0,0 +1,341 @@
+// File: bench.cpp
+// Description: This program times the hot paths of the engine and the console board one call at a time, and reports
+//              nanoseconds and heap allocations per call so that a slowdown shows up before a build is shipped.
+// Usage: battleship-bench [seconds per benchmark] [seed]
+
+#include "GameEngine.h"
+#include "Player.h"
+#include "Ship.h"
+#include "Board.h"
+#include "Coord.h"
+#include "Random.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+#ifndef BATTLESHIP_BENCH
+#error "Build the benchmarks with -DBATTLESHIP_BENCH so that PlayerBench can reach the private methods of Player"
+#endif
+
+const double DEFAULT_SECONDS = 0.2;
+const int WARMUP_ROUNDS = 16;
+const int NAME_SPACING = 42;
+const int VALUE_SPACING = 14;
+
+atomic<long long> numAllocations(0); // Every call to operator new since the program started
+volatile long long sink = 0; // Results are added here so the compiler can't drop the calls being timed
+
+// Count every heap allocation. The array and nothrow forms call these, so they are counted too.
+void* operator new(size_t size) {
+    numAllocations.fetch_add(1, memory_order_relaxed);
+    void* memory = malloc((size > 0) ? size : 1);
+
+    if (memory == nullptr) {
+        throw bad_alloc();
+    }
+
+    return memory;
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+/**
+ * Reaches the private methods of Player that are worth timing on their own.
+ */
+class PlayerBench {
+public:
+    static Player::ShotResult ShootCoord(Player& player, Coord coord, Player& opponent) {
+        return player.ShootCoord(coord, opponent);
+    }
+
+    static bool IsValidCoord(const Player& player, const Board& board, Coord coord) {
+        return player.IsValidCoord(board, coord);
+    }
+
+    static bool IsValidCoord(const Player& player, const Board& board, Coord coord, int length, Ship::Direction direction) {
+        return player.IsValidCoord(board, coord, length, direction);
+    }
+
+    static void DisplayShips(const Player& player) {
+        player.DisplayBoard(player.state.shipBoard, "Ships", true);
+    }
+
+    static const Board& GetOffensiveBoard(const Player& player) {
+        return player.state.offensiveBoard;
+    }
+
+    static const Board& GetShipBoard(const Player& player) {
+        return player.state.shipBoard;
+    }
+};
+
+/**
+ * Time and allocations of one benchmark.
+ */
+struct BenchResult {
+    string name;
+    long long ops = 0;
+    double nsPerOp = 0;
+    double allocationsPerOp = 0;
+};
+
+double MeasureTimerOverhead();
+template <typename Setup, typename Op>
+BenchResult RunBenchmark(const string& name, int opsPerRound, double minSeconds, double timerOverhead, Setup setup, Op op);
+vector<Player::State> RecordComputerStates(Player::Difficulty difficulty, uint64_t seed);
+void DisplayResult(const BenchResult& result);
+
+int main(int argc, char* argv[]) {
+    const int MID_GAME_SHOTS = 40;
+
+    double minSeconds = (argc > 1) ? atof(argv[1]) : DEFAULT_SECONDS;
+    uint64_t seed = (argc > 2) ? strtoull(argv[2], nullptr, 10) : 1;
+
+    if (minSeconds <= 0) {
+        minSeconds = DEFAULT_SECONDS;
+    }
+
+    double timerOverhead = MeasureTimerOverhead();
+    cout << "Timing each benchmark for " << minSeconds << " s with seed " << seed << " (timer overhead "
+         << fixed << setprecision(1) << timerOverhead * 1e9 << " ns per round, subtracted).\n\n";
+    cout << left << setw(NAME_SPACING) << "Benchmark" << right << setw(VALUE_SPACING) << "ns/op"
+         << setw(VALUE_SPACING) << "allocs/op" << "\n";
+    cout << string(NAME_SPACING + 2 * VALUE_SPACING, '-') << "\n";
+
+    // A game with both fleets placed, and a copy of it some calls in.
+    Player hard("HARD COMPUTER", true, true, true);
+    hard.SetDifficulty(Player::HARD);
+    GameEngine game(hard, hard, seed);
+    game.GenerateComputerShips();
+    Player& shooter = game.GetPlayer(0);
+    Player& target = game.GetPlayer(1);
+    Player::State shooterStart = shooter.Snapshot();
+    Player::State targetStart = target.Snapshot();
+
+    GameEngine midGame(hard, hard, seed);
+    midGame.GenerateComputerShips();
+
+    for (int i = 0; i < MID_GAME_SHOTS && !midGame.IsOver(); i++) {
+        midGame.Step(midGame.GetComputerShot());
+    }
+
+    const Player& midPlayer = midGame.GetPlayer(0);
+    const Ship* midShips = midGame.GetPlayer(1).GetShips();
+
+    // Every cell in a random order, so a round shoots the whole board once.
+    unsigned char cellOrder[Bitboard::NUM_CELLS];
+    Random random(seed);
+
+    for (int i = 0; i < Bitboard::NUM_CELLS; i++) {
+        cellOrder[i] = i;
+    }
+
+    for (int i = Bitboard::NUM_CELLS - 1; i > 0; i--) {
+        int j = random.NextInt(i + 1);
+        unsigned char temp = cellOrder[i];
+        cellOrder[i] = cellOrder[j];
+        cellOrder[j] = temp;
+    }
+
+    auto noSetup = [](long long) {};
+
+    DisplayResult(RunBenchmark("Player::ShootCoord", Bitboard::NUM_CELLS, minSeconds, timerOverhead,
+        [&](long long) {
+            shooter.Restore(shooterStart);
+            target.Restore(targetStart);
+        },
+        [&](int i) {
+            sink += PlayerBench::ShootCoord(shooter, Coord::FromIndex(cellOrder[i]), target).shipId;
+        }));
+
+    DisplayResult(RunBenchmark("Ship::IsShipSunk", Player::MAX_SHIPS, minSeconds, timerOverhead, noSetup,
+        [&](int i) {
+            sink += midShips[i].IsShipSunk();
+        }));
+
+    DisplayResult(RunBenchmark("Player::IsValidCoord (call)", Bitboard::NUM_CELLS, minSeconds, timerOverhead, noSetup,
+        [&](int i) {
+            sink += PlayerBench::IsValidCoord(midPlayer, PlayerBench::GetOffensiveBoard(midPlayer), Coord::FromIndex(i));
+        }));
+
+    // Every cell and direction for each length, against a board that already has a whole fleet.
+    DisplayResult(RunBenchmark("Player::IsValidCoord (placement)", Bitboard::NUM_CELLS * Ship::NUM_DIRECTIONS, minSeconds,
+                               timerOverhead, noSetup,
+        [&](int i) {
+            int length = Player::SHIP_LENGTHS[(i / Ship::NUM_DIRECTIONS) % Player::MAX_SHIPS];
+            Ship::Direction direction = static_cast<Ship::Direction>(i % Ship::NUM_DIRECTIONS);
+            sink += PlayerBench::IsValidCoord(midPlayer, PlayerBench::GetShipBoard(midPlayer),
+                                              Coord::FromIndex(i / Ship::NUM_DIRECTIONS), length, direction);
+        }));
+
+    Player placer("HARD COMPUTER", true, true, true);
+    placer.SetDifficulty(Player::HARD);
+
+    DisplayResult(RunBenchmark("Player::GenerateShips (computer)", 1, minSeconds, timerOverhead,
+        [&](long long) {
+            placer.Reset();
+        },
+        [&](int) {
+            placer.GenerateShips();
+        }));
+
+    // Call from every position a computer was in during a real game, one position per round.
+    const Player::Difficulty PROMPT_DIFFICULTIES[] = {Player::EASY, Player::HARD};
+    const string PROMPT_NAMES[] = {"Player::PromptComputerCoord (easy)", "Player::PromptComputerCoord (hard)"};
+
+    for (int i = 0; i < 2; i++) {
+        Player::Difficulty difficulty = PROMPT_DIFFICULTIES[i];
+        vector<Player::State> states = RecordComputerStates(difficulty, seed);
+        Player caller("COMPUTER", true, true, difficulty == Player::HARD);
+        caller.SetDifficulty(difficulty);
+
+        DisplayResult(RunBenchmark(PROMPT_NAMES[i], 1, minSeconds, timerOverhead,
+            [&](long long round) {
+                caller.Restore(states[round % states.size()]);
+            },
+            [&](int) {
+                sink += caller.PromptComputerCoord().GetIndex();
+            }));
+    }
+
+    // Boards are written to stdout, so point it at /dev/null while they are timed.
+    cout.flush();
+    int savedStdout = dup(STDOUT_FILENO);
+    int nullFd = open("/dev/null", O_WRONLY);
+
+    if (savedStdout < 0 || nullFd < 0) {
+        cout << "Error opening /dev/null.\n";
+        return 1;
+    }
+
+    dup2(nullFd, STDOUT_FILENO);
+    close(nullFd);
+
+    BenchResult display = RunBenchmark("Player::DisplayBoard (null sink)", 1, minSeconds, timerOverhead, noSetup,
+        [&](int) {
+            PlayerBench::DisplayShips(midPlayer);
+        });
+
+    cout.flush();
+    dup2(savedStdout, STDOUT_FILENO);
+    close(savedStdout);
+    DisplayResult(display);
+
+    return 0;
+}
+
+/**
+ * Finds how long it takes to read the clock twice, which every round of a benchmark pays on top of its calls.
+ * @return Seconds per round.
+ */
+double MeasureTimerOverhead() {
+    const int NUM_SAMPLES = 100000;
+
+    double total = 0;
+
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        auto start = chrono::steady_clock::now();
+        auto end = chrono::steady_clock::now();
+        total += chrono::duration<double>(end - start).count();
+    }
+
+    return total / NUM_SAMPLES;
+}
+
+/**
+ * Times an operation in rounds until enough time has been spent in it. Setup runs before each round and is not counted.
+ * @param name Name of the benchmark.
+ * @param opsPerRound Number of calls in a round.
+ * @param minSeconds Time to spend in the calls.
+ * @param timerOverhead Time to take off each round for reading the clock.
+ * @param setup Called with the round number before each round.
+ * @param op Called with the call number within the round.
+ * @return Time and allocations per call.
+ */
+template <typename Setup, typename Op>
+BenchResult RunBenchmark(const string& name, int opsPerRound, double minSeconds, double timerOverhead, Setup setup, Op op) {
+    BenchResult result;
+    result.name = name;
+    double seconds = 0; // Time spent in counted rounds, clock reads included
+    long long rounds = 0;
+    long long allocations = 0;
+
+    for (long long round = -WARMUP_ROUNDS; round < 0 || seconds < minSeconds; round++) {
+        setup(round + WARMUP_ROUNDS);
+        long long allocationsBefore = numAllocations.load(memory_order_relaxed);
+        auto start = chrono::steady_clock::now();
+
+        for (int i = 0; i < opsPerRound; i++) {
+            op(i);
+        }
+
+        auto end = chrono::steady_clock::now();
+
+        if (round >= 0) { // Warmup rounds fill the caches and are not counted
+            seconds += chrono::duration<double>(end - start).count();
+            rounds++;
+            allocations += numAllocations.load(memory_order_relaxed) - allocationsBefore;
+            result.ops += opsPerRound;
+        }
+    }
+
+    // The overhead is only taken off at the end. Taking it off each round could shrink the total when a round is
+    // quicker than the measured overhead, and the loop would never reach minSeconds.
+    double opSeconds = seconds - rounds * timerOverhead;
+    result.nsPerOp = (opSeconds > 0) ? opSeconds * 1e9 / result.ops : 0.0;
+    result.allocationsPerOp = static_cast<double>(allocations) / result.ops;
+    return result;
+}
+
+/**
+ * Plays a game between two computers and keeps the state of the first one before each of its calls.
+ * @param difficulty How both computers pick their shots.
+ * @param seed Seed of the game.
+ * @return The states, in the order of the calls.
+ */
+vector<Player::State> RecordComputerStates(Player::Difficulty difficulty, uint64_t seed) {
+    Player computer("COMPUTER", true, true, difficulty == Player::HARD);
+    computer.SetDifficulty(difficulty);
+    GameEngine game(computer, computer, seed);
+    game.GenerateComputerShips();
+    vector<Player::State> states;
+
+    while (!game.IsOver()) {
+        if (game.GetCurrentPlayer() == 0) {
+            states.push_back(game.GetPlayer(0).Snapshot());
+        }
+
+        game.Step(game.GetComputerShot());
+    }
+
+    return states;
+}
+
+/**
+ * Outputs one line of the results table.
+ * @param result Time and allocations of a benchmark.
+ */
+void DisplayResult(const BenchResult& result) {
+    const int NS_PRECISION = 1;
+    const int ALLOCATION_PRECISION = 2;
+
+    cout << left << setw(NAME_SPACING) << result.name << right << fixed
+         << setw(VALUE_SPACING) << setprecision(NS_PRECISION) << result.nsPerOp
+         << setw(VALUE_SPACING) << setprecision(ALLOCATION_PRECISION) << result.allocationsPerOp << "\n";
+}
@@ -0,0 +1,137 @@
+// File: bitboard_test.cpp
+// Description: This program checks that shifting a Bitboard moves every cell to its neighbour on the grid and drops the
+//              cells that would leave it, instead of wrapping them into the next or previous row, and that runs of
+//              cells cover the cells a ship would.
+// Usage: battleship-bitboard-test
+
+#include "Bitboard.h"
+#include <iostream>
+#include <string>
+using namespace std;
+
+bool CheckShift(const string& name, int index, Bitboard shifted, int row, int col);
+bool CheckWrapAround();
+bool CheckRuns();
+
+int main() {
+    const int SIZE = Bitboard::SIZE;
+
+    bool passed = true;
+
+    // Every cell on its own, in every direction.
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            int index = Bitboard::Index(row, col);
+            Bitboard cell;
+            cell.Set(index);
+
+            passed &= CheckShift("ShiftNorth", index, cell.ShiftNorth(), row - 1, col);
+            passed &= CheckShift("ShiftEast", index, cell.ShiftEast(), row, col + 1);
+            passed &= CheckShift("ShiftSouth", index, cell.ShiftSouth(), row + 1, col);
+            passed &= CheckShift("ShiftWest", index, cell.ShiftWest(), row, col - 1);
+        }
+    }
+
+    passed &= CheckWrapAround();
+    passed &= CheckRuns();
+
+    cout << (passed ? "All bitboard tests passed.\n" : "Some bitboard tests failed.\n");
+    return passed ? 0 : 1;
+}
+
+/**
+ * Checks that a board holding one cell was shifted onto the expected cell, or emptied if that cell is off the grid.
+ * @param name Name of the shift.
+ * @param index Bit index of the cell before the shift.
+ * @param shifted The board after the shift.
+ * @param row Expected row after the shift.
+ * @param col Expected column after the shift.
+ * @return Whether or not the shift was correct.
+ */
+bool CheckShift(const string& name, int index, Bitboard shifted, int row, int col) {
+    const int SIZE = Bitboard::SIZE;
+
+    Bitboard expected;
+
+    if (row >= 0 && row < SIZE && col >= 0 && col < SIZE) {
+        expected.Set(Bitboard::Index(row, col));
+    }
+
+    if (shifted != expected) {
+        cout << "FAILED: " << name << " of cell " << index << " gave " << shifted.Count() << " cell(s) in the wrong place.\n";
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Checks the edge between rows G and H, where the last column of row G (cell 69) is the first cell of the high word
+ * that belongs to the last column.
+ * @return Whether or not neither edge cell crossed into the other row.
+ */
+bool CheckWrapAround() {
+    const int G_LAST = Bitboard::Index(6, Bitboard::SIZE - 1);
+    const int H_FIRST = Bitboard::Index(7, 0);
+
+    bool passed = true;
+    Bitboard first;
+    first.Set(H_FIRST);
+    Bitboard last;
+    last.Set(G_LAST);
+
+    if (first.ShiftWest().Test(G_LAST)) {
+        cout << "FAILED: ShiftWest wrapped row H's first column into row G's last column.\n";
+        passed = false;
+    }
+
+    if (last.ShiftEast().Test(H_FIRST)) {
+        cout << "FAILED: ShiftEast wrapped row G's last column into row H's first column.\n";
+        passed = false;
+    }
+
+    // The whole board shifted west loses exactly the first column.
+    if (Bitboard::Full().ShiftWest().Count() != Bitboard::NUM_CELLS - Bitboard::SIZE) {
+        cout << "FAILED: ShiftWest of the full board kept " << Bitboard::Full().ShiftWest().Count() << " cells.\n";
+        passed = false;
+    }
+
+    return passed;
+}
+
+/**
+ * Checks every run that fits on the board against the same cells set one at a time.
+ * @return Whether or not every run was correct.
+ */
+bool CheckRuns() {
+    const int SIZE = Bitboard::SIZE;
+
+    bool passed = true;
+
+    for (int index = 0; index < Bitboard::NUM_CELLS; index++) {
+        int row = index / SIZE;
+        int col = index % SIZE;
+
+        for (int length = 1; length <= Bitboard::MAX_RUN; length++) {
+            Bitboard across;
+            Bitboard down;
+
+            for (int i = 0; i < length; i++) {
+                across.Set(index + i);
+                down.Set(index + i * SIZE);
+            }
+
+            if (col + length <= SIZE && Bitboard::Run(index, length, false) != across) {
+                cout << "FAILED: Run of " << length << " across from cell " << index << ".\n";
+                passed = false;
+            }
+
+            if (row + length <= SIZE && Bitboard::Run(index, length, true) != down) {
+                cout << "FAILED: Run of " << length << " down from cell " << index << ".\n";
+                passed = false;
+            }
+        }
+    }
+
+    return passed;
+}
@@ -0,0 +1,404 @@
+// File: macrobench.cpp
+// Description: This program plays the same seeded games of a hard computer against every computer opponent in both
+//              modes several times, reports the median of how fast they ran, and fails if they got slower than a
+//              recorded baseline.
+// Usage: battleship-macrobench [--record] [baseline file] [tolerance]
+
+#include "GameEngine.h"
+#include "Player.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+using namespace std;
+
+const long long CORPUS_GAMES = 5000;
+const int NUM_RUNS = 7; // Times each pair plays the corpus; the median run is compared, so one noisy run can't fail it
+const uint64_t CORPUS_SEED = 20241028; // Game N of every pair is seeded with CORPUS_SEED + N
+const double DEFAULT_TOLERANCE = 0.25; // Games/sec may drop this much below the baseline before the run fails
+const double INSTRUCTION_TOLERANCE = 0.05; // Instructions barely move between runs, so they get a tighter bound
+const string DEFAULT_BASELINE = "macrobench_baseline.txt";
+const string RECORD_FLAG = "--record";
+const int LABEL_SPACING = 20;
+const int VALUE_SPACING = 16;
+const int SPREAD_SPACING = 10;
+
+/**
+ * An opponent and mode the hard computer plays the corpus in.
+ */
+struct Pair {
+    string name;
+    bool isClassic;
+    Player::Difficulty opponent;
+};
+
+/**
+ * What one pair's games cost, measured or from the baseline.
+ */
+struct PairResult {
+    string name;
+    double seconds = 0; // Of the median run
+    double gamesPerSec = 0; // Median of the runs
+    double spread = 0; // Fastest run's games/sec over the slowest's, minus 1
+    double instructionsPerGame = 0; // Median of the runs, or 0 if the instructions couldn't be counted
+};
+
+int OpenInstructionCounter();
+PairResult RunPair(const Pair& pair, int counter);
+void PlayCorpus(const Pair& pair, int counter, double& seconds, double& instructions);
+double GetMedian(vector<double> values);
+long long GetPeakRssKb();
+bool LoadBaseline(const string& path, vector<PairResult>& baseline);
+bool WriteBaseline(const string& path, const vector<PairResult>& results);
+bool CompareToBaseline(const vector<PairResult>& results, const vector<PairResult>& baseline, double tolerance);
+void DisplayResult(const PairResult& result);
+
+int main(int argc, char* argv[]) {
+    int arg = 1;
+    bool record = argc > arg && argv[arg] == RECORD_FLAG;
+
+    if (record) {
+        arg++;
+    }
+
+    string baselinePath = (argc > arg) ? argv[arg] : DEFAULT_BASELINE;
+    double tolerance = (argc > arg + 1) ? atof(argv[arg + 1]) : DEFAULT_TOLERANCE;
+
+    if (tolerance <= 0 || tolerance >= 1) {
+        tolerance = DEFAULT_TOLERANCE;
+    }
+
+    vector<Pair> pairs = {
+        {"Easy (Classic)", true, Player::EASY},
+        {"Hard (Classic)", true, Player::HARD},
+        {"Expert (Classic)", true, Player::EXPERT},
+        {"Easy (Salvo)", false, Player::EASY},
+        {"Hard (Salvo)", false, Player::HARD},
+        {"Expert (Salvo)", false, Player::EXPERT}
+    };
+
+    int counter = OpenInstructionCounter();
+    cout << "Playing " << CORPUS_GAMES << " games of a hard computer against each opponent with seed " << CORPUS_SEED
+         << ", " << NUM_RUNS << " times" << ((counter < 0) ? " (instructions can't be counted here).\n\n" : ".\n\n");
+    cout << left << setw(LABEL_SPACING) << "Opponent" << right << setw(VALUE_SPACING) << "Seconds"
+         << setw(VALUE_SPACING) << "Games/sec" << setw(SPREAD_SPACING) << "Spread" << setw(VALUE_SPACING) << "Instr/game"
+         << "\n";
+    cout << string(LABEL_SPACING + 3 * VALUE_SPACING + SPREAD_SPACING, '-') << "\n";
+
+    vector<PairResult> results;
+
+    for (const Pair& pair : pairs) {
+        results.push_back(RunPair(pair, counter));
+        DisplayResult(results.back());
+    }
+
+    if (counter >= 0) {
+        close(counter);
+    }
+
+    cout << "\n" << left << setw(LABEL_SPACING) << "Peak RSS" << GetPeakRssKb() << " KB\n" << right;
+
+    if (record) {
+        if (!WriteBaseline(baselinePath, results)) {
+            cout << "Error opening baseline file " << baselinePath << ".\n";
+            return 1;
+        }
+
+        cout << "Recorded the baseline in " << baselinePath << ".\n";
+        return 0;
+    }
+
+    vector<PairResult> baseline;
+
+    if (!LoadBaseline(baselinePath, baseline)) {
+        cout << "Error opening baseline file " << baselinePath << ".\n";
+        return 1;
+    }
+
+    return CompareToBaseline(results, baseline, tolerance) ? 0 : 1;
+}
+
+/**
+ * Opens a counter of the instructions this thread runs in user space. It starts disabled.
+ * @return File descriptor of the counter, or -1 if the system doesn't allow one.
+ */
+int OpenInstructionCounter() {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+/**
+ * Plays the corpus for one pair NUM_RUNS times, after one run to warm up, and takes the median of the runs.
+ * @param pair Opponent and mode.
+ * @param counter Instruction counter, or -1 if there is none.
+ * @return What the games cost.
+ */
+PairResult RunPair(const Pair& pair, int counter) {
+    vector<double> seconds;
+    vector<double> rates;
+    vector<double> instructions;
+
+    for (int run = -1; run < NUM_RUNS; run++) {
+        double runSeconds = 0;
+        double runInstructions = 0;
+        PlayCorpus(pair, counter, runSeconds, runInstructions);
+
+        if (run < 0) { // The first run fills the caches and is not counted
+            continue;
+        }
+
+        seconds.push_back(runSeconds);
+        rates.push_back((runSeconds > 0) ? CORPUS_GAMES / runSeconds : 0.0);
+        instructions.push_back(runInstructions);
+    }
+
+    PairResult result;
+    result.name = pair.name;
+    result.seconds = GetMedian(seconds);
+    result.gamesPerSec = GetMedian(rates);
+    result.instructionsPerGame = GetMedian(instructions);
+
+    double slowest = *min_element(rates.begin(), rates.end());
+    double fastest = *max_element(rates.begin(), rates.end());
+    result.spread = (slowest > 0) ? fastest / slowest - 1 : 0.0;
+    return result;
+}
+
+/**
+ * Plays the corpus for one pair once, timing it and counting its instructions.
+ * @param pair Opponent and mode.
+ * @param counter Instruction counter, or -1 if there is none.
+ * @param seconds Set to the wall time of the games.
+ * @param instructions Set to the instructions per game, or 0 if they couldn't be counted.
+ */
+void PlayCorpus(const Pair& pair, int counter, double& seconds, double& instructions) {
+    Player first("HARD COMPUTER", true, pair.isClassic, true);
+    first.SetDifficulty(Player::HARD);
+    Player second("OPPONENT", true, pair.isClassic, pair.opponent == Player::HARD);
+    second.SetDifficulty(pair.opponent);
+    GameEngine game(first, second, CORPUS_SEED);
+
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    auto start = chrono::steady_clock::now();
+
+    for (long long gameNum = 0; gameNum < CORPUS_GAMES; gameNum++) {
+        game.Reset(CORPUS_SEED + gameNum);
+        game.GenerateComputerShips();
+
+        while (!game.IsOver()) {
+            game.Step(game.GetComputerShot());
+        }
+    }
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    seconds = elapsed.count();
+    instructions = 0;
+
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t count = 0;
+
+        if (read(counter, &count, sizeof(count)) == sizeof(count)) {
+            instructions = static_cast<double>(count) / CORPUS_GAMES;
+        }
+    }
+}
+
+/**
+ * Finds the middle of some values.
+ * @param values The values; there must be at least one.
+ * @return The middle value, or the mean of the two middle values if there is an even number of them.
+ */
+double GetMedian(vector<double> values) {
+    sort(values.begin(), values.end());
+    size_t middle = values.size() / 2;
+    return (values.size() % 2 == 1) ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+/**
+ * Gets the most memory the program has had resident at once.
+ * @return Peak resident set size in kilobytes.
+ */
+long long GetPeakRssKb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss; // Already in kilobytes on Linux
+}
+
+/**
+ * Reads a baseline file: one line per pair holding its name, games/sec and instructions/game, separated by tabs.
+ * Lines starting with # are comments.
+ * @param path Path of the file.
+ * @param baseline Set to the pairs of the file.
+ * @return Whether or not the file could be read.
+ */
+bool LoadBaseline(const string& path, vector<PairResult>& baseline) {
+    ifstream file(path);
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    string line;
+
+    while (getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        istringstream fields(line);
+        PairResult result;
+        getline(fields, result.name, '\t');
+        fields >> result.gamesPerSec >> result.instructionsPerGame;
+
+        if (fields) {
+            baseline.push_back(result);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Writes the results as a new baseline file.
+ * @param path Path of the file.
+ * @param results Results of every pair.
+ * @return Whether or not the file could be written.
+ */
+bool WriteBaseline(const string& path, const vector<PairResult>& results) {
+    ofstream file(path);
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << "# Written by battleship-macrobench --record. Both values are medians of " << NUM_RUNS << " runs. Games/sec\n"
+         << "# depends on the machine, so record it again on new hardware. Instructions/game is 0 where instructions\n"
+         << "# couldn't be counted, and is then reported as not measured instead of being compared.\n"
+         << "# pair\tgames/sec\tinstructions/game\n";
+    file << fixed << setprecision(0);
+
+    for (const PairResult& result : results) {
+        file << result.name << "\t" << result.gamesPerSec << "\t" << result.instructionsPerGame << "\n";
+    }
+
+    return file.good();
+}
+
+/**
+ * Checks every pair against its baseline and reports the ones that regressed or have no baseline, and the pairs whose
+ * instructions weren't measured by this run or the baseline.
+ * @param results Results of this run.
+ * @param baseline Results of the baseline.
+ * @param tolerance Fraction games/sec may drop by.
+ * @return Whether or not every pair held up.
+ */
+bool CompareToBaseline(const vector<PairResult>& results, const vector<PairResult>& baseline, double tolerance) {
+    const int PRECISION = 1;
+
+    bool passed = true;
+    int numUnmeasured = 0; // Pairs only checked on games/sec
+    cout << fixed << setprecision(PRECISION);
+
+    if (baseline.empty()) {
+        cout << "The baseline has no pairs to compare against.\n";
+        passed = false;
+    }
+
+    for (const PairResult& result : results) {
+        const PairResult* base = nullptr;
+
+        for (const PairResult& candidate : baseline) {
+            if (candidate.name == result.name) {
+                base = &candidate;
+            }
+        }
+
+        if (base == nullptr) {
+            cout << "MISSING: " << result.name << " has no baseline.\n";
+            passed = false;
+            continue;
+        }
+
+        double speed = result.gamesPerSec / base->gamesPerSec;
+
+        if (speed < 1 - tolerance) {
+            cout << "REGRESSION: " << result.name << " ran at " << speed * 100 << "% of its baseline games/sec.\n";
+            passed = false;
+        }
+
+        // Instructions can only be compared when both runs counted them; 0 means they weren't measured.
+        if (base->instructionsPerGame <= 0) {
+            cout << "NOT MEASURED: " << result.name << " has no instructions/game in its baseline.\n";
+            numUnmeasured++;
+        } else if (result.instructionsPerGame <= 0) {
+            cout << "NOT MEASURED: " << result.name << "'s instructions/game couldn't be counted in this run.\n";
+            numUnmeasured++;
+        } else {
+            double growth = result.instructionsPerGame / base->instructionsPerGame;
+
+            if (growth > 1 + INSTRUCTION_TOLERANCE) {
+                cout << "REGRESSION: " << result.name << " took " << growth * 100 << "% of its baseline instructions/game.\n";
+                passed = false;
+            }
+        }
+    }
+
+    if (!passed) {
+        cout << "Some pairs have no baseline, or are not within " << tolerance * 100 << "% of their baseline games/sec "
+             << "or " << INSTRUCTION_TOLERANCE * 100 << "% of their baseline instructions/game.\n";
+    } else if (numUnmeasured > 0) {
+        cout << "Every pair is within " << tolerance * 100 << "% of its baseline games/sec, but " << numUnmeasured
+             << " of them were only checked on games/sec.\n";
+    } else {
+        cout << "Every pair is within " << tolerance * 100 << "% of its baseline games/sec and "
+             << INSTRUCTION_TOLERANCE * 100 << "% of its baseline instructions/game.\n";
+    }
+
+    return passed;
+}
+
+/**
+ * Outputs one line of the results table.
+ * @param result What a pair's games cost.
+ */
+void DisplayResult(const PairResult& result) {
+    const int SECONDS_PRECISION = 3;
+    const int RATE_PRECISION = 0;
+    const int SPREAD_PRECISION = 1;
+
+    cout << left << setw(LABEL_SPACING) << result.name << right << fixed << setprecision(SECONDS_PRECISION)
+         << setw(VALUE_SPACING) << result.seconds << setprecision(RATE_PRECISION) << setw(VALUE_SPACING) << result.gamesPerSec
+         << setprecision(SPREAD_PRECISION) << setw(SPREAD_SPACING - 1) << result.spread * 100 << "%"
+         << setprecision(RATE_PRECISION);
+
+    if (result.instructionsPerGame > 0) {
+        cout << setw(VALUE_SPACING) << result.instructionsPerGame << "\n";
+    } else {
+        cout << setw(VALUE_SPACING) << "n/a" << "\n";
+    }
+}
@@ -5,45 +5,74 @@
 // Description: This program will let the user play games of battleship.
 // Usage: This program will ask the user to choose whether they would like to go against another player or the
 //        computer, ask them to set up their ships, and ask them to shoot at coordinates.
+//        battleship --quiet [games] [E|H|X|M] [C|S] skips the menu and has a hard computer play the chosen computer
+//        without displaying anything but the final stats.
 
+#include "GameEngine.h"
 #include "Player.h"
+#include "Replay.h"
+#include "Stats.h"
 #include "Ship.h"
 #include <iostream>
 #include <iomanip>
 #include <string>
 #include <vector>
 #include <limits>
-#include <ctime>
+#include <chrono>
+#include <cstdint>
 #include <cctype>
 #include <cstdlib>
 #include <sstream>
 #include <fstream>
+#include <algorithm>
 using namespace std;
 
 void DisplayMainMenu();
 void DisplayTutorial();
-void DisplayOpponentsMenu(bool& isComputer, bool& isHardmode);
-void DisplayOpponent(bool isComputer, bool isHardmode);
+void DisplayOpponentsMenu(bool& isComputer, Player::Difficulty& difficulty);
+void DisplayOpponent(bool isComputer, Player::Difficulty difficulty);
 void DisplayModesMenu(bool& isClassic);
 void DisplayMode(bool isClassic);
-void PlayGame(bool isComputer, bool isClassic, bool isHardmode);
+void PlayGame(bool isComputer, bool isClassic, Player::Difficulty difficulty);
+void PlayBatch(bool isClassic, Player::Difficulty difficulty, long long numGames);
+string GetComputerName(Player::Difficulty difficulty);
+bool ReadComputerLetter(char letter, Player::Difficulty& difficulty);
+long long ReadNumGames();
 
 void CreateIndicator(string msg, vector<string> labels, int index);
 char ReadUserLetter();
 
-int main(){
+int main(int argc, char* argv[]) {
     const char PLAY_CHAR = 'P';
+    const char BATCH_CHAR = 'B';
     const char HOW_CHAR = 'H';
     const char MODES_CHAR = 'M';
     const char OPPONENT_CHAR = 'O';
     const char QUIT_CHAR = 'Q';
+    const char SALVO_CHAR = 'S';
+    const string QUIET_FLAG = "--quiet";
 
-    // Constantly prompts user to input a letter, checking if they quit the game or start the game from the menu.
     bool isComputer = true;
     bool isClassic = true;
-    bool isHardmode = false;
+    Player::Difficulty difficulty = Player::EASY;
     char menuInput;
 
+    // Runs a batch straight from the command line, without the menu.
+    if (argc > 1 && argv[1] == QUIET_FLAG) {
+        long long numGames = (argc > 2) ? atoll(argv[2]) : 1;
+
+        if (numGames < 1 || (argc > 3 && !ReadComputerLetter(toupper(argv[3][0]), difficulty))) {
+            cout << "Usage: battleship --quiet [games] [E|H|X|M] [C|S]\n";
+            return 1;
+        }
+
+        isClassic = !(argc > 4 && toupper(argv[4][0]) == SALVO_CHAR);
+        PlayBatch(isClassic, difficulty, numGames);
+        return 0;
+    }
+
+    // Constantly prompts user to input a letter, checking if they quit the game or start the game from the menu.
+
     do {
         DisplayMainMenu();
         menuInput = toupper(ReadUserLetter()); // Prompt user for letter in the main menu
@@ -53,18 +82,28 @@ int main(){
         }
         
         if (menuInput == OPPONENT_CHAR) { // User enters opponent select
-            DisplayOpponentsMenu(isComputer, isHardmode);
+            DisplayOpponentsMenu(isComputer, difficulty);
         } 
         
         if (menuInput == MODES_CHAR) { // User enters modes menu
             DisplayModesMenu(isClassic);
         }
+
+        if (menuInput == BATCH_CHAR && !isComputer) { // Both players of a batch are computers
+            cout << "\nChoose a computer opponent before running a batch.";
+            menuInput = OPPONENT_CHAR;
+        }
     
-    } while(!( (menuInput == QUIT_CHAR) || (menuInput == PLAY_CHAR) )); // Loop ends if user quits or plays
+    } while(!( (menuInput == QUIT_CHAR) || (menuInput == PLAY_CHAR) || (menuInput == BATCH_CHAR) )); // Loop ends if user quits or plays
     
     // Begins game if user enters play.
     if (menuInput == PLAY_CHAR) {
-        PlayGame(isComputer, isClassic, isHardmode);
+        PlayGame(isComputer, isClassic, difficulty);
+    }
+
+    // Begins quiet computer-vs-computer games if user enters batch.
+    if (menuInput == BATCH_CHAR) {
+        PlayBatch(isClassic, difficulty, ReadNumGames());
     }
 
     // Thanks user for playing the game in a battleship-like way.
@@ -95,6 +134,7 @@ void DisplayMainMenu() {
 
     cout << "\n\n<<<<<<<<<<<<<<<<< BATTLESHIP >>>>>>>>>>>>>>>>>>" << "\n" << left
          << setw(MENU_WIDTH) << "" << "> PLAY (P)" << "\n"
+         << setw(MENU_WIDTH) << "" << "> COMPUTER BATCH (B)" << "\n"
          << setw(MENU_WIDTH) << "" << "> HOW TO PLAY (H)" << "\n"
          << setw(MENU_WIDTH) << "" << "> MODES (M)" << "\n"
          << setw(MENU_WIDTH) << "" << "> OPPONENT SELECT (O)\n"
@@ -171,13 +211,16 @@ void CreateIndicator(string msg, vector<string> labels, int index) {
 /**
  * Displays the opponents menu.
  * @param isComputer Whether or not the opponent is a computer.
+ * @param difficulty How the computer opponent picks its shots.
  */
-void DisplayOpponentsMenu(bool& isComputer, bool& isHardmode) {
+void DisplayOpponentsMenu(bool& isComputer, Player::Difficulty& difficulty) {
     const char EASY_COMPUTER_CHAR = 'E';
     const char HARD_COMPUTER_CHAR = 'H';
+    const char EXPERT_COMPUTER_CHAR = 'X';
+    const char MONTE_CARLO_COMPUTER_CHAR = 'M';
     const char OTHER_USER_CHAR = 'O';
 
-    DisplayOpponent(isComputer, isHardmode);
+    DisplayOpponent(isComputer, difficulty);
     cout << "\nEnter letter to choose an opponent: ";
     
     // Reads user input to determine the opponent.
@@ -185,21 +228,31 @@ void DisplayOpponentsMenu(bool& isComputer, bool& isHardmode) {
 
     if (menuInput == OTHER_USER_CHAR) {
         isComputer = false;
-        isHardmode = false;
-        DisplayOpponent(isComputer, isHardmode);
+        difficulty = Player::EASY;
+        DisplayOpponent(isComputer, difficulty);
         cout << "\nYou will be playing against another user.";
     } else if (menuInput == EASY_COMPUTER_CHAR) {
         isComputer = true;
-        isHardmode = false;
-        DisplayOpponent(isComputer, isHardmode);
+        difficulty = Player::EASY;
+        DisplayOpponent(isComputer, difficulty);
         cout << "\nYou will be playing against the easy computer.";
     } else if (menuInput == HARD_COMPUTER_CHAR) {
         isComputer = true;
-        isHardmode = true;
-        DisplayOpponent(isComputer, isHardmode);
+        difficulty = Player::HARD;
+        DisplayOpponent(isComputer, difficulty);
         cout << "\nYou will be playing against the hard computer.";
+    } else if (menuInput == EXPERT_COMPUTER_CHAR) {
+        isComputer = true;
+        difficulty = Player::EXPERT;
+        DisplayOpponent(isComputer, difficulty);
+        cout << "\nYou will be playing against the expert computer. Good luck, Captain.";
+    } else if (menuInput == MONTE_CARLO_COMPUTER_CHAR) {
+        isComputer = true;
+        difficulty = Player::MONTE_CARLO;
+        DisplayOpponent(isComputer, difficulty);
+        cout << "\nYou will be playing against the Monte Carlo computer. It has already imagined your fleet a thousand ways.";
     } else {
-        DisplayOpponent(isComputer, isHardmode);
+        DisplayOpponent(isComputer, difficulty);
         cout << "\nYour opponent selection has not been changed.";
     }
 
@@ -211,18 +264,23 @@ void DisplayOpponentsMenu(bool& isComputer, bool& isHardmode) {
 /**
  * Indicates the opponent the user would like to go against.
  * @param isComputer Whether or not the opponent is a computer.
- * @param isHardmode Whether or not the computer player is going to be hard to fight against.
+ * @param difficulty How the computer opponent picks its shots.
  */
-void DisplayOpponent(bool isComputer, bool isHardmode) {
+void DisplayOpponent(bool isComputer, Player::Difficulty difficulty) {
     string prompt = "Choose an opponent";
-    vector<string> labels = { "EASY COMPUTER (E)", "HARD COMPUTER (H)", "OTHER USER (O)" };
+    vector<string> labels = { "EASY COMPUTER (E)", "HARD COMPUTER (H)", "EXPERT COMPUTER (X)", "MONTE CARLO COMPUTER (M)",
+                              "OTHER USER (O)" };
 
-    if (isComputer && !isHardmode) {
+    if (isComputer && difficulty == Player::EASY) {
         CreateIndicator(prompt, labels, 0);
-    } else if (isComputer && isHardmode) {
+    } else if (isComputer && difficulty == Player::HARD) {
         CreateIndicator(prompt, labels, 1);
-    } else {
+    } else if (isComputer && difficulty == Player::EXPERT) {
         CreateIndicator(prompt, labels, 2);
+    } else if (isComputer && difficulty == Player::MONTE_CARLO) {
+        CreateIndicator(prompt, labels, 3);
+    } else {
+        CreateIndicator(prompt, labels, 4);
     }
 }
 
@@ -276,18 +334,15 @@ void DisplayMode(bool isClassic) {
  * Starts the game.
  * @param isComputer Whether or not the other player is a computer.
  * @param isClassic Whether or not the mode is classic.
- * @param isHardmode Whether or not the computer will be hard to play against.
+ * @param difficulty How the computer opponent picks its shots.
  */
-void PlayGame(bool isComputer, bool isClassic, bool isHardmode) {
-    const string USER_NAME = "USER";
-    const string OPP_USER_NAME = "SECOND USER";
-    const string EASY_COMPUTER_NAME = "EASY COMPUTER";
-    const string HARD_COMPUTER_NAME = "HARD COMPUTER";
+void PlayGame(bool isComputer, bool isClassic, Player::Difficulty difficulty) {
     const int NUM_PLAYERS = 2;
 
     // Create player names.
     string userName;
-    string opponentName = isHardmode ? HARD_COMPUTER_NAME : EASY_COMPUTER_NAME;
+    string opponentName = GetComputerName(difficulty);
+
     cout << "\nGreetings, captains. What are your names?\n";
     cout << "Player 1: ";
     getline(cin, userName);
@@ -300,13 +355,15 @@ void PlayGame(bool isComputer, bool isClassic, bool isHardmode) {
     }
 
     // Deciding player to start.
-    Player user(userName, false, isClassic, false);
-    Player opponent(opponentName, isComputer, isClassic, isHardmode);
+    uint64_t seed = chrono::system_clock::now().time_since_epoch().count();
+    Player opponentSetup(opponentName, isComputer, isClassic, difficulty == Player::HARD);
+    opponentSetup.SetDifficulty(difficulty);
+    GameEngine game(Player(userName, false, isClassic, false), opponentSetup, seed);
+    Player& user = game.GetPlayer(0);
+    Player& opponent = game.GetPlayer(1);
     vector<Player*> players;
 
-    srand(time(0));
-    int randNum = rand() % NUM_PLAYERS; // 0 = User starts, 1 = Opponent starts
-    string startingPlayer = (randNum == 0) ? user.GetName() : opponent.GetName();
+    string startingPlayer = (game.GetStartingPlayer() == 0) ? user.GetName() : opponent.GetName();
 
     cout << "\n\nGreetings, Captain " << user.GetName() << " and Captain " << opponent.GetName() << ".\n";
     cout << "The first player will be...\n" << startingPlayer << ".\n";
@@ -314,7 +371,7 @@ void PlayGame(bool isComputer, bool isClassic, bool isHardmode) {
     // Order players array considering startingPlayer (first is first, second is second).
     Player* userPtr = &user;
     Player* opponentPtr = &opponent;
-    if (startingPlayer == user.GetName()) {
+    if (game.GetStartingPlayer() == 0) {
         players.push_back(userPtr);
         players.push_back(opponentPtr);
     } else {
@@ -335,16 +392,26 @@ void PlayGame(bool isComputer, bool isClassic, bool isHardmode) {
     
     cout << "\nNow, Captain " << startingPlayer << " goes first.\n";
 
-    while (user.GetShipsDestroyed() != MAX_SHIPS && opponent.GetShipsDestroyed() != MAX_SHIPS) {
-        for (int i = 0; i < NUM_PLAYERS; i++) { 
-            Player* player = players[i];
-            Player* otherPlayer = (i == 0) ? players[1] : players[0]; // pointer to opposing player
-            player->Turn(*otherPlayer);
-        }
-    }
+    while (!game.IsOver()) {
+        int shooter = game.GetCurrentPlayer();
+        Player* player = &game.GetPlayer(shooter);
+        Player* otherPlayer = &game.GetPlayer((shooter + 1) % NUM_PLAYERS); // pointer to opposing player
+        GameEngine::Result result;
+
+        player->AnnounceTurn(*otherPlayer);
 
-    user.DeleteShips();
-    opponent.DeleteShips();
+        // Prompts player until their turn's calls are used, checking if their coordinates haven't already been called.
+        do {
+            Coord playerCoord = player->IsComputer() ? game.GetComputerShot() : player->PromptUserCoord();
+            result = game.Step(playerCoord);
+
+            if (!player->IsComputer() && !result.accepted) {
+                cout << "You cannot call a previous coordinate, Captain.\n";
+            }
+        } while (!result.turnOver);
+
+        player->AnnounceResults(result.shots, result.numShots, *otherPlayer);
+    }
 
     // Game ends, output loss message.
     cout << "\nCaptain ";
@@ -358,6 +425,23 @@ void PlayGame(bool isComputer, bool isClassic, bool isHardmode) {
 
     cout << loserName << " has been defeated!\n\n";
 
+    // Record the game in the replay log.
+    const string REPLAY_FILE = "replays.bin";
+    ReplayWriter replay;
+
+    if (!replay.Open(REPLAY_FILE) || !replay.Write(game) || !replay.Flush()) {
+        cout << "Error recording the game in " << REPLAY_FILE << ".\n\n";
+    }
+
+    // Add the game to the running totals of every game played.
+    const string STATS_FILE = "stats.csv";
+    StatsAggregator stats(STATS_FILE, StatsAggregator::CSV);
+    stats.AddAccumulator().Record(game);
+
+    if (!stats.Flush()) {
+        cout << "Error updating " << STATS_FILE << ".\n\n";
+    }
+
     // Output stats (ships destroyed and accuracy).
     const string OUTPUT_FILE = "outputfile.txt";
     const int USER_SPACING = 25;
@@ -365,7 +449,7 @@ void PlayGame(bool isComputer, bool isClassic, bool isHardmode) {
     const int ACCURACY_PRECISION = 2;
     const char DIVIDER = '-';
 
-    ofstream outputFile(OUTPUT_FILE);
+    ofstream outputFile(OUTPUT_FILE, ios::app); // Every game's table is kept
     
     if (!outputFile.is_open()) {
         cout << "\nError opening file.\n";
@@ -373,7 +457,6 @@ void PlayGame(bool isComputer, bool isClassic, bool isHardmode) {
     }
 
     // Output game stats.
-    ostringstream playerRow; // Player names
     string userResult = "";
     string opponentResult = "";
 
@@ -385,43 +468,227 @@ void PlayGame(bool isComputer, bool isClassic, bool isHardmode) {
         opponentResult = opponentName + " (lost)";
     }
 
-    playerRow << left << setw(USER_SPACING) << "Player" << setw(OPPONENT_SPACING) << userResult << opponentResult << "\n";
-    string playerRowStr = playerRow.str();
+    ostringstream userAccuracy; // Appends percentage and keeps precision of accuracies
+    userAccuracy << fixed << setprecision(ACCURACY_PRECISION) << user.GetAccuracy() << "%";
+    ostringstream opponentAccuracy;
+    opponentAccuracy << fixed << setprecision(ACCURACY_PRECISION) << opponent.GetAccuracy() << "%";
 
-    ostringstream tableHeader; // Header of table
-    tableHeader << left;
-    tableHeader << "Game Stats:\n";
-    string divider(playerRowStr.length() - 1, DIVIDER); // Account for newline (increases string length)
-    tableHeader << divider << "\n";
-    string tableHeaderStr = tableHeader.str();
+    int dividerLength = USER_SPACING + max(OPPONENT_SPACING, static_cast<int>(userResult.length())) + opponentResult.length();
+    ostringstream table;
+    table << left;
+    table << "Game Stats:\n";
+    table << string(dividerLength, DIVIDER) << "\n";
+    table << setw(USER_SPACING) << "Player" << setw(OPPONENT_SPACING) << userResult << opponentResult << "\n";
+    table << setw(USER_SPACING) << "Ships Destroyed" << setw(OPPONENT_SPACING) << user.GetShipsDestroyed() << opponent.GetShipsDestroyed() << "\n";
+    table << setw(USER_SPACING) << "Hits" << setw(OPPONENT_SPACING) << user.GetHitCount() << opponent.GetHitCount() << "\n";
+    table << setw(USER_SPACING) << "Calls" << setw(OPPONENT_SPACING) << user.GetCallCount() << opponent.GetCallCount() << "\n";
+    table << setw(USER_SPACING) << "Accuracy" << setw(OPPONENT_SPACING) << userAccuracy.str() << opponentAccuracy.str() << "\n";
+    table << setw(USER_SPACING) << "Seed" << game.GetSeed() << "\n"; // Seed needed to replay the game
+    string tableStr = table.str();
+
+    // Output everything to terminal and file.
+    cout << tableStr;
+    outputFile << tableStr << "\n";
+
+#ifdef BATTLESHIP_INSTRUMENT
+    cout << "\n" << Instrument::Summarize(user.GetName(), user.GetInstrument())
+         << Instrument::Summarize(opponent.GetName(), opponent.GetInstrument());
+#endif
+}
 
-    ostringstream shipsDestroyedRow; // Ships destroyed
-    shipsDestroyedRow << left;
-    shipsDestroyedRow << setw(USER_SPACING) << "Ships Destroyed" << setw(OPPONENT_SPACING) << user.GetShipsDestroyed() << opponent.GetShipsDestroyed() << "\n";
-    string shipsDestroyedRowStr = shipsDestroyedRow.str();
+/**
+ * Has a hard computer play a number of games against another computer without displaying them, then outputs the
+ * stats of all the games. The games are recorded like any other.
+ * @param isClassic Whether or not the mode is classic.
+ * @param difficulty How the second computer picks its shots.
+ * @param numGames Number of games to play.
+ */
+void PlayBatch(bool isClassic, Player::Difficulty difficulty, long long numGames) {
+    const string FIRST_NAME = GetComputerName(Player::HARD);
+    const string SECOND_NAME = GetComputerName(difficulty);
+    const int NUM_PLAYERS = 2;
 
-    ostringstream hits;
-    hits << left;
-    hits << setw(USER_SPACING) << "Hits" << setw(OPPONENT_SPACING) << user.GetHitCount() << opponent.GetHitCount() << "\n";
-    string hitsStr = hits.str();
+    // Game N of the batch is seeded with seed + N, so any one of them can be played again.
+    uint64_t seed = chrono::system_clock::now().time_since_epoch().count();
+    Player firstSetup(FIRST_NAME, true, isClassic, true);
+    firstSetup.SetDifficulty(Player::HARD);
+    Player secondSetup(SECOND_NAME, true, isClassic, difficulty == Player::HARD);
+    secondSetup.SetDifficulty(difficulty);
+    GameEngine game(firstSetup, secondSetup, seed);
+
+    const string REPLAY_FILE = "replays.bin";
+    const string STATS_FILE = "stats.csv";
+    ReplayWriter replay;
+    bool recording = replay.Open(REPLAY_FILE);
+    StatsAggregator stats(STATS_FILE, StatsAggregator::CSV);
+    StatsAccumulator& totals = stats.AddAccumulator();
+
+    long long wins[NUM_PLAYERS] = {};
+    long long shipsDestroyed[NUM_PLAYERS] = {};
+    long long hits[NUM_PLAYERS] = {};
+    long long calls[NUM_PLAYERS] = {};
+    long long winnerTurns = 0;
+
+#ifdef BATTLESHIP_INSTRUMENT
+    // Every game's summary goes to a file, as there are too many to show.
+    const string INSTRUMENT_FILE = "instrument.txt";
+    ofstream instrumentFile(INSTRUMENT_FILE, ios::app);
+#endif
+
+    auto start = chrono::steady_clock::now();
+
+    for (long long gameNum = 0; gameNum < numGames; gameNum++) {
+        game.Reset(seed + gameNum);
+        game.GenerateComputerShips();
+
+        while (!game.IsOver()) {
+            game.Step(game.GetComputerShot());
+        }
 
-    ostringstream calls;
-    calls << left;
-    calls << setw(USER_SPACING) << "Calls" << setw(OPPONENT_SPACING) << user.GetCallCount() << opponent.GetCallCount() << "\n";
-    string callsStr = calls.str();
+        if (recording) {
+            recording = replay.Write(game);
+        }
 
-    ostringstream userAccuracy; // Appends percentage and keeps precision of accuracies
-    userAccuracy << fixed << setprecision(ACCURACY_PRECISION) << user.GetAccuracy() << "%";
-    ostringstream opponentAccuracy;
-    opponentAccuracy << fixed << setprecision(ACCURACY_PRECISION) << opponent.GetAccuracy() << "%";
-    ostringstream accuracies;
-    accuracies << left << fixed << setprecision(ACCURACY_PRECISION);
-    accuracies << setw(USER_SPACING) << "Accuracy" << setw(OPPONENT_SPACING) << userAccuracy.str() << opponentAccuracy.str() << "\n";
-    string accuraciesStr = accuracies.str();
+        totals.Record(game);
+        wins[game.GetWinner()]++;
+
+#ifdef BATTLESHIP_INSTRUMENT
+        instrumentFile << "Game " << gameNum << " (seed " << game.GetSeed() << ")\n"
+                       << Instrument::Summarize(FIRST_NAME, game.GetPlayer(0).GetInstrument())
+                       << Instrument::Summarize(SECOND_NAME, game.GetPlayer(1).GetInstrument()) << "\n";
+#endif
+        winnerTurns += (game.GetTurnCount() + 1) / 2; // The winner took the last turn, so they took the extra one if any
+
+        for (int i = 0; i < NUM_PLAYERS; i++) {
+            const Player& player = game.GetPlayer(i);
+            shipsDestroyed[i] += player.GetShipsDestroyed();
+            hits[i] += player.GetHitCount();
+            calls[i] += player.GetCallCount();
+        }
+    }
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    double seconds = elapsed.count();
+
+    if (!recording || !replay.Flush()) {
+        cout << "Error recording the games in " << REPLAY_FILE << ".\n\n";
+    }
+
+    if (!stats.Flush()) {
+        cout << "Error updating " << STATS_FILE << ".\n\n";
+    }
+
+    // Output stats (wins, ships destroyed and accuracy over every game).
+    const string OUTPUT_FILE = "outputfile.txt";
+    const int LABEL_SPACING = 25;
+    const int FIRST_SPACING = 25;
+    const int PRECISION = 2;
+    const char DIVIDER = '-';
+
+    ofstream outputFile(OUTPUT_FILE, ios::app); // Every game's table is kept
+
+    if (!outputFile.is_open()) {
+        cout << "\nError opening file.\n";
+        return;
+    }
+
+    ostringstream table;
+    table << left << fixed << setprecision(PRECISION);
+    table << "Batch Stats:\n";
+    table << string(LABEL_SPACING + FIRST_SPACING + SECOND_NAME.length(), DIVIDER) << "\n";
+    table << setw(LABEL_SPACING) << "Player" << setw(FIRST_SPACING) << FIRST_NAME << SECOND_NAME << "\n";
+    table << setw(LABEL_SPACING) << "Wins" << setw(FIRST_SPACING) << wins[0] << wins[1] << "\n";
+    table << setw(LABEL_SPACING) << "Ships Destroyed" << setw(FIRST_SPACING) << shipsDestroyed[0] << shipsDestroyed[1] << "\n";
+    table << setw(LABEL_SPACING) << "Hits" << setw(FIRST_SPACING) << hits[0] << hits[1] << "\n";
+    table << setw(LABEL_SPACING) << "Calls" << setw(FIRST_SPACING) << calls[0] << calls[1] << "\n";
+
+    ostringstream firstAccuracy; // Appends percentage and keeps precision of accuracies
+    firstAccuracy << fixed << setprecision(PRECISION) << 100.0 * hits[0] / calls[0] << "%";
+    ostringstream secondAccuracy;
+    secondAccuracy << fixed << setprecision(PRECISION) << 100.0 * hits[1] / calls[1] << "%";
+
+    table << setw(LABEL_SPACING) << "Accuracy" << setw(FIRST_SPACING) << firstAccuracy.str() << secondAccuracy.str() << "\n";
+    table << setw(LABEL_SPACING) << "Mode" << (isClassic ? "CLASSIC" : "SALVO") << "\n";
+    table << setw(LABEL_SPACING) << "Games" << numGames << "\n";
+    table << setw(LABEL_SPACING) << "Turns to Win (mean)" << static_cast<double>(winnerTurns) / numGames << "\n";
+    table << setw(LABEL_SPACING) << "Games/sec" << ((seconds > 0) ? numGames / seconds : 0.0) << "\n";
+    table << setw(LABEL_SPACING) << "Seed" << seed << "\n"; // Seed of the first game
+    string tableStr = table.str();
+
+    // Output everything to terminal and file.
+    cout << tableStr;
+    outputFile << tableStr << "\n";
+}
+
+/**
+ * Gets the name of a computer player.
+ * @param difficulty How the computer picks its shots.
+ * @return Name of the computer.
+ */
+string GetComputerName(Player::Difficulty difficulty) {
+    const string EASY_COMPUTER_NAME = "EASY COMPUTER";
+    const string HARD_COMPUTER_NAME = "HARD COMPUTER";
+    const string EXPERT_COMPUTER_NAME = "EXPERT COMPUTER";
+    const string MONTE_CARLO_COMPUTER_NAME = "MONTE CARLO COMPUTER";
+
+    if (difficulty == Player::HARD) {
+        return HARD_COMPUTER_NAME;
+    } else if (difficulty == Player::EXPERT) {
+        return EXPERT_COMPUTER_NAME;
+    } else if (difficulty == Player::MONTE_CARLO) {
+        return MONTE_CARLO_COMPUTER_NAME;
+    }
+
+    return EASY_COMPUTER_NAME;
+}
+
+/**
+ * Reads the letter of a computer opponent, as used in the opponents menu.
+ * @param letter The letter in uppercase.
+ * @param difficulty Set to the computer's difficulty if the letter is one.
+ * @return Whether or not the letter names a computer.
+ */
+bool ReadComputerLetter(char letter, Player::Difficulty& difficulty) {
+    const char EASY_COMPUTER_CHAR = 'E';
+    const char HARD_COMPUTER_CHAR = 'H';
+    const char EXPERT_COMPUTER_CHAR = 'X';
+    const char MONTE_CARLO_COMPUTER_CHAR = 'M';
+
+    if (letter == EASY_COMPUTER_CHAR) {
+        difficulty = Player::EASY;
+    } else if (letter == HARD_COMPUTER_CHAR) {
+        difficulty = Player::HARD;
+    } else if (letter == EXPERT_COMPUTER_CHAR) {
+        difficulty = Player::EXPERT;
+    } else if (letter == MONTE_CARLO_COMPUTER_CHAR) {
+        difficulty = Player::MONTE_CARLO;
+    } else {
+        return false;
+    }
 
-    // Outpt everything to terminal.
-    cout << tableHeaderStr << playerRowStr << shipsDestroyedRowStr << hitsStr << callsStr << accuraciesStr;
+    return true;
+}
 
-    // Output to file.
-    outputFile << tableHeaderStr << playerRowStr << shipsDestroyedRowStr << hitsStr << callsStr << accuraciesStr;
-}
\ No newline at end of file
+/**
+ * Prompts the user for the number of games in a batch until they enter a positive number.
+ * @return Number of games.
+ */
+long long ReadNumGames() {
+    const long long MAX_INPUT = numeric_limits<streamsize>::max();
+
+    long long numGames = 0;
+    cout << "\nHow many games should the computers play? ";
+
+    while (!(cin >> numGames) || numGames < 1) {
+        if (cin.eof()) {
+            return 1;
+        }
+
+        cin.clear();
+        cin.ignore(MAX_INPUT, '\n');
+        cout << "Please enter a positive number of games: ";
+    }
+
+    cin.ignore(MAX_INPUT, '\n');
+    return numGames;
+}
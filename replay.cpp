@@ -0,0 +1,135 @@
+// File: replay.cpp
+// Description: This program reads a binary replay log and plays every game in it again through the engine to check
+//              that the recorded results still hold, or shows one game of the log.
+// Usage: battleship-replay <replay file> [game number]
+
+#include "Replay.h"
+#include "GameEngine.h"
+#include "Player.h"
+#include "Ship.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+using namespace std;
+
+const int LABEL_SPACING = 25;
+
+bool VerifyAll(const ReplayReader& reader);
+void DisplayGame(const Replay::Record& record, long long gameNum);
+string FormatCoord(Coord coord);
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cout << "Usage: battleship-replay <replay file> [game number]\n";
+        return 1;
+    }
+
+    ReplayReader reader;
+
+    if (!reader.Open(argv[1])) {
+        cout << "Error opening replay file " << argv[1] << ".\n";
+        return 1;
+    }
+
+    if (argc < 3) {
+        return VerifyAll(reader) ? 0 : 1;
+    }
+
+    long long gameNum = atoll(argv[2]);
+    Replay::Record record;
+
+    if (!reader.GetGame(gameNum, record)) {
+        cout << "The log only has " << reader.GetNumGames() << " games.\n";
+        return 1;
+    }
+
+    DisplayGame(record, gameNum);
+    return Replay::Verify(record) ? 0 : 1;
+}
+
+/**
+ * Plays every game of a log again and reports how many of them matched their records.
+ * @param reader The open log.
+ * @return Whether or not every game matched.
+ */
+bool VerifyAll(const ReplayReader& reader) {
+    const int PRECISION = 2;
+    const int MAX_REPORTED = 10;
+
+    long long mismatched = 0;
+    long long gameNum = 0;
+    uint64_t offset = reader.Begin();
+    Replay::Record record;
+    auto start = chrono::steady_clock::now();
+
+    while (reader.Next(offset, record)) {
+        if (!Replay::Verify(record)) {
+            if (mismatched < MAX_REPORTED) {
+                cout << "Game " << gameNum << " (seed " << record.seed << ") does not match its record.\n";
+            }
+
+            mismatched++;
+        }
+
+        gameNum++;
+    }
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    double seconds = elapsed.count();
+
+    cout << left << fixed << setprecision(PRECISION);
+    cout << setw(LABEL_SPACING) << "Games" << gameNum << "\n";
+    cout << setw(LABEL_SPACING) << "Games/sec" << ((seconds > 0) ? gameNum / seconds : 0.0) << "\n";
+    cout << setw(LABEL_SPACING) << "Mismatched" << mismatched << "\n";
+    cout << right;
+    return mismatched == 0;
+}
+
+/**
+ * Outputs one game of a log: its setup, both fleets and every call in order.
+ * @param record The game.
+ * @param gameNum Index of the game in the log.
+ */
+void DisplayGame(const Replay::Record& record, long long gameNum) {
+    const string DIFFICULTY_NAMES[] = {"EASY", "HARD", "EXPERT", "MONTE CARLO"};
+    const int SHOTS_PER_LINE = 10;
+
+    cout << left;
+    cout << setw(LABEL_SPACING) << "Game" << gameNum << "\n";
+    cout << setw(LABEL_SPACING) << "Seed" << record.seed << "\n";
+    cout << setw(LABEL_SPACING) << "Mode" << (record.isClassic ? "CLASSIC" : "SALVO") << "\n";
+
+    for (int i = 0; i < GameEngine::NUM_PLAYERS; i++) {
+        string label = "Player " + to_string(i + 1);
+        string kind = record.isComputer[i] ? DIFFICULTY_NAMES[record.difficulty[i]] + " COMPUTER" : "USER";
+        cout << setw(LABEL_SPACING) << label << kind << "\n";
+
+        for (int shipId = 0; shipId < Player::MAX_SHIPS; shipId++) {
+            cout << setw(LABEL_SPACING) << ("  " + string(Player::SHIP_NAMES[shipId]))
+                 << FormatCoord(record.shipCoords[i][shipId]) << " "
+                 << Ship::DIRECTION_NAMES[record.shipDirections[i][shipId]] << "\n";
+        }
+    }
+
+    cout << setw(LABEL_SPACING) << "First player" << "Player " << record.startingPlayer + 1 << "\n";
+    cout << setw(LABEL_SPACING) << "Winner" << "Player " << record.winner + 1 << "\n";
+    cout << setw(LABEL_SPACING) << "Calls" << record.numShots << "\n";
+
+    for (int i = 0; i < record.numShots; i++) {
+        cout << FormatCoord(Coord::FromIndex(record.shots[i])) << (((i + 1) % SHOTS_PER_LINE == 0) ? "\n" : " ");
+    }
+
+    cout << "\n" << right;
+}
+
+/**
+ * Writes a coordinate the way the console game asks for it, like A1 or J10.
+ * @param coord Coordinate on the board.
+ * @return Text of the coordinate.
+ */
+string FormatCoord(Coord coord) {
+    return string(1, static_cast<char>('A' + coord.row)) + to_string(coord.col + 1);
+}
@@ -0,0 +1,307 @@
+// File: sim.cpp
+// Description: This program plays computer-vs-computer games of battleship across all cores and reports how
+//              the computer opponents perform against each other.
+// Usage: battleship-sim [games per matchup] [threads] [seed] [replay file] [stats file]
+
+#include "GameEngine.h"
+#include "Player.h"
+#include "Replay.h"
+#include "Stats.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <memory>
+using namespace std;
+
+const int MAX_TURNS = Player::MAX_SIZE * Player::MAX_SIZE; // A player can't take more turns than there are cells
+const long long CHUNK_SIZE = 256;
+const int STATS_FLUSH_MS = 1000;
+
+/**
+ * A pairing of computer opponents to simulate.
+ */
+struct Matchup {
+    string name;
+    bool isClassic;
+    Player::Difficulty first;
+    Player::Difficulty second;
+};
+
+/**
+ * Results gathered by one worker thread. Workers never share one, so no locking is needed until they are merged.
+ */
+struct SimStats {
+    long long games = 0;
+    long long wins[GameEngine::NUM_PLAYERS] = {0, 0};
+    long long totalTurns = 0;
+    long long turnHistogram[MAX_TURNS + 1] = {}; // Turns the winner needed, indexed by turn count
+};
+
+/**
+ * A worker's share of the games. The owner takes chunks from the front and idle workers steal from the back.
+ */
+struct WorkQueue {
+    mutex lock;
+    deque<pair<long long, long long>> chunks; // [begin, end) ranges of game numbers
+};
+
+/**
+ * A replay log shared by every worker. Records are small, so workers take turns adding them to one buffer.
+ */
+struct SharedReplay {
+    mutex lock;
+    ReplayWriter writer;
+};
+
+void RunWorker(int workerId, vector<WorkQueue>& queues, const Matchup& matchup, uint64_t baseSeed, SharedReplay* replay,
+               StatsAccumulator* totals, SimStats& stats);
+bool TakeChunk(int workerId, vector<WorkQueue>& queues, pair<long long, long long>& chunk);
+void PlaySimGame(GameEngine& game, uint64_t seed, SharedReplay* replay, StatsAccumulator* totals, SimStats& stats);
+void MergeStats(SimStats& total, const SimStats& stats);
+int GetTurnPercentile(const SimStats& stats, double percentile);
+void DisplayResults(const Matchup& matchup, const SimStats& stats, double seconds);
+
+int main(int argc, char* argv[]) {
+    const long long DEFAULT_GAMES = 10000;
+
+    long long numGames = (argc > 1) ? atoll(argv[1]) : DEFAULT_GAMES;
+    int numThreads = (argc > 2) ? atoi(argv[2]) : thread::hardware_concurrency();
+    uint64_t baseSeed = (argc > 3) ? strtoull(argv[3], nullptr, 10) : chrono::system_clock::now().time_since_epoch().count();
+
+    if (numGames <= 0) {
+        numGames = DEFAULT_GAMES;
+    }
+
+    if (numThreads <= 0) { // hardware_concurrency() may not know
+        numThreads = 1;
+    }
+
+    SharedReplay replay;
+
+    if (argc > 4 && argv[4][0] != '\0' && !replay.writer.Open(argv[4])) { // An empty name skips the log
+        cout << "Error opening replay file " << argv[4] << ".\n";
+        return 1;
+    }
+
+    // Running totals go to CSV, or to JSONL if the file is named that way.
+    unique_ptr<StatsAggregator> aggregator;
+
+    if (argc > 5 && argv[5][0] != '\0') {
+        string statsPath = argv[5];
+        const string JSONL_EXTENSION = ".jsonl";
+        bool isJsonl = statsPath.length() >= JSONL_EXTENSION.length() &&
+                       statsPath.compare(statsPath.length() - JSONL_EXTENSION.length(), string::npos, JSONL_EXTENSION) == 0;
+        aggregator.reset(new StatsAggregator(statsPath, isJsonl ? StatsAggregator::JSONL : StatsAggregator::CSV));
+        aggregator->StartAutoFlush(STATS_FLUSH_MS);
+    }
+
+    vector<Matchup> matchups = {
+        {"Easy vs Hard (Classic)", true, Player::EASY, Player::HARD},
+        {"Hard vs Hard (Classic)", true, Player::HARD, Player::HARD},
+        {"Hard vs Expert (Classic)", true, Player::HARD, Player::EXPERT},
+        {"Easy vs Hard (Salvo)", false, Player::EASY, Player::HARD},
+        {"Hard vs Hard (Salvo)", false, Player::HARD, Player::HARD},
+        {"Hard vs Expert (Salvo)", false, Player::HARD, Player::EXPERT}
+    };
+
+    cout << "Simulating " << numGames << " games per matchup on " << numThreads << " thread" << ((numThreads > 1) ? "s" : "")
+         << " with seed " << baseSeed << ".\n";
+
+    for (const Matchup& matchup : matchups) {
+        // Deal the games out to the workers in chunks.
+        vector<WorkQueue> queues(numThreads);
+        long long chunkCount = 0;
+
+        for (long long begin = 0; begin < numGames; begin += CHUNK_SIZE) {
+            long long end = (begin + CHUNK_SIZE < numGames) ? begin + CHUNK_SIZE : numGames;
+            queues[chunkCount % numThreads].chunks.push_back(make_pair(begin, end));
+            chunkCount++;
+        }
+
+        vector<SimStats> workerStats(numThreads);
+        vector<thread> workers;
+        auto start = chrono::steady_clock::now();
+
+        for (int i = 0; i < numThreads; i++) {
+            StatsAccumulator* totals = (aggregator != nullptr) ? &aggregator->AddAccumulator() : nullptr;
+            workers.push_back(thread(RunWorker, i, ref(queues), cref(matchup), baseSeed,
+                                     replay.writer.IsOpen() ? &replay : nullptr, totals, ref(workerStats[i])));
+        }
+
+        for (thread& worker : workers) {
+            worker.join();
+        }
+
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+        SimStats total;
+        for (const SimStats& stats : workerStats) {
+            MergeStats(total, stats);
+        }
+
+        DisplayResults(matchup, total, elapsed.count());
+    }
+
+    return 0;
+}
+
+/**
+ * Plays games until there is no work left to take or steal.
+ * @param workerId Index of the worker's own queue.
+ * @param queues Every worker's queue.
+ * @param matchup The opponents to simulate.
+ * @param baseSeed Seed of the first game; game N uses baseSeed + N no matter which worker plays it.
+ * @param replay Log to record every game in, or nullptr.
+ * @param totals The worker's accumulator of running totals, or nullptr.
+ * @param stats The worker's own results.
+ */
+void RunWorker(int workerId, vector<WorkQueue>& queues, const Matchup& matchup, uint64_t baseSeed, SharedReplay* replay,
+               StatsAccumulator* totals, SimStats& stats) {
+    Player first("FIRST COMPUTER", true, matchup.isClassic, false);
+    Player second("SECOND COMPUTER", true, matchup.isClassic, false);
+    first.SetDifficulty(matchup.first);
+    second.SetDifficulty(matchup.second);
+
+    GameEngine game(first, second, baseSeed); // Reset for every game instead of being rebuilt
+    pair<long long, long long> chunk;
+
+    while (TakeChunk(workerId, queues, chunk)) {
+        for (long long gameNum = chunk.first; gameNum < chunk.second; gameNum++) {
+            PlaySimGame(game, baseSeed + gameNum, replay, totals, stats);
+        }
+    }
+}
+
+/**
+ * Takes the next chunk from the worker's own queue, or steals one from another worker once it runs dry.
+ * @param workerId Index of the worker's own queue.
+ * @param queues Every worker's queue.
+ * @param chunk Receives the range of games to play.
+ * @return Whether or not any work was found.
+ */
+bool TakeChunk(int workerId, vector<WorkQueue>& queues, pair<long long, long long>& chunk) {
+    int numQueues = queues.size();
+
+    for (int i = 0; i < numQueues; i++) {
+        int victim = (workerId + i) % numQueues; // Own queue first
+        WorkQueue& queue = queues[victim];
+        lock_guard<mutex> guard(queue.lock);
+
+        if (queue.chunks.empty()) {
+            continue;
+        }
+
+        if (victim == workerId) {
+            chunk = queue.chunks.front();
+            queue.chunks.pop_front();
+        } else {
+            chunk = queue.chunks.back();
+            queue.chunks.pop_back();
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * Plays one computer-vs-computer game to the end and records the result.
+ * @param game The worker's game, which is reset to start this one.
+ * @param seed Seed of the game.
+ * @param replay Log to record the game in, or nullptr.
+ * @param totals Running totals to add the game to, or nullptr.
+ * @param stats The results to add to.
+ */
+void PlaySimGame(GameEngine& game, uint64_t seed, SharedReplay* replay, StatsAccumulator* totals, SimStats& stats) {
+    game.Reset(seed);
+    game.GenerateComputerShips();
+
+    while (!game.IsOver()) {
+        game.Step(game.GetComputerShot());
+    }
+
+    if (replay != nullptr) {
+        lock_guard<mutex> guard(replay->lock);
+        replay->writer.Write(game);
+    }
+
+    if (totals != nullptr) {
+        totals->Record(game);
+    }
+
+    int winnerTurns = (game.GetTurnCount() + 1) / 2; // The winner took the last turn, so they took the extra one if any
+    stats.games++;
+    stats.wins[game.GetWinner()]++;
+    stats.totalTurns += winnerTurns;
+    stats.turnHistogram[(winnerTurns < MAX_TURNS) ? winnerTurns : MAX_TURNS]++;
+}
+
+/**
+ * Adds one worker's results into a total.
+ * @param total The combined results.
+ * @param stats A worker's results.
+ */
+void MergeStats(SimStats& total, const SimStats& stats) {
+    total.games += stats.games;
+    total.totalTurns += stats.totalTurns;
+
+    for (int i = 0; i < GameEngine::NUM_PLAYERS; i++) {
+        total.wins[i] += stats.wins[i];
+    }
+
+    for (int i = 0; i <= MAX_TURNS; i++) {
+        total.turnHistogram[i] += stats.turnHistogram[i];
+    }
+}
+
+/**
+ * Finds the number of turns the winner needed in a given fraction of games.
+ * @param stats The combined results.
+ * @param percentile Fraction of games between 0 and 1.
+ * @return Turns to win at that percentile.
+ */
+int GetTurnPercentile(const SimStats& stats, double percentile) {
+    long long target = static_cast<long long>(percentile * stats.games);
+    long long seen = 0;
+
+    for (int turns = 0; turns <= MAX_TURNS; turns++) {
+        seen += stats.turnHistogram[turns];
+
+        if (seen > target) {
+            return turns;
+        }
+    }
+
+    return MAX_TURNS;
+}
+
+/**
+ * Outputs the results of a matchup.
+ * @param matchup The simulated opponents.
+ * @param stats The combined results.
+ * @param seconds Wall time the matchup took.
+ */
+void DisplayResults(const Matchup& matchup, const SimStats& stats, double seconds) {
+    const int LABEL_SPACING = 25;
+    const int PRECISION = 2;
+
+    double games = (stats.games > 0) ? stats.games : 1;
+
+    cout << "\n" << matchup.name << ":\n" << left << fixed << setprecision(PRECISION);
+    cout << setw(LABEL_SPACING) << "Games" << stats.games << "\n";
+    cout << setw(LABEL_SPACING) << "Games/sec" << ((seconds > 0) ? stats.games / seconds : 0.0) << "\n";
+    cout << setw(LABEL_SPACING) << "Mean turns to win" << stats.totalTurns / games << "\n";
+    cout << setw(LABEL_SPACING) << "p50 turns to win" << GetTurnPercentile(stats, 0.50) << "\n";
+    cout << setw(LABEL_SPACING) << "p99 turns to win" << GetTurnPercentile(stats, 0.99) << "\n";
+    cout << setw(LABEL_SPACING) << "First computer wins" << (stats.wins[0] / games) * 100.0 << "%\n";
+    cout << setw(LABEL_SPACING) << "Second computer wins" << (stats.wins[1] / games) * 100.0 << "%\n";
+    cout << right;
+}